@@ -0,0 +1,176 @@
+/**
+ * @file platform_config.h
+ * @brief 編譯後配置檔（config blob）格式
+ *
+ * /etc/config/gaming-platform 由 gaming-platform-config 工具解析、驗證後，
+ * 寫成固定大小的二進位 blob。各行程以唯讀 mmap 載入，
+ * 檢查標頭後直接將映射位址轉型為 platform_config_t 使用，不需再解析文字。
+ *
+ * 此標頭檔為 HAL 內部使用，不安裝給應用層。
+ * 修改 platform_config_t 佈局時必須遞增 PLATFORM_CONFIG_VERSION。
+ */
+
+#ifndef PLATFORM_CONFIG_H
+#define PLATFORM_CONFIG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define PLATFORM_CONFIG_MAGIC       0x46435047u  /* "GPCF" */
+#define PLATFORM_CONFIG_VERSION     4
+#define PLATFORM_CONFIG_PATH_MAX    64
+#define PLATFORM_CONFIG_MAX_BUTTONS 8
+#define PLATFORM_CONFIG_LED_CHANNELS 3           /* R, G, B */
+#define PLATFORM_CONFIG_NO_REG      0xFFFFFFFFu  /* 暫存器不存在 */
+#define PLATFORM_CONFIG_IFNAME_MAX  16           /* IFNAMSIZ */
+
+#ifndef PLATFORM_CONFIG_BLOB_PATH
+#define PLATFORM_CONFIG_BLOB_PATH "/var/run/gaming-platform/config.bin"
+#endif
+
+/* ============================================================================
+ * 預設值（沒有 blob 或 UCI 未設定該選項時使用，可於編譯時以 -D 覆寫）
+ * ========================================================================== */
+
+#ifndef PLATFORM_DEFAULT_LED_RED
+#define PLATFORM_DEFAULT_LED_RED    "/sys/class/leds/red:status"
+#endif
+
+#ifndef PLATFORM_DEFAULT_LED_GREEN
+#define PLATFORM_DEFAULT_LED_GREEN  "/sys/class/leds/green:status"
+#endif
+
+#ifndef PLATFORM_DEFAULT_LED_BLUE
+#define PLATFORM_DEFAULT_LED_BLUE   "/sys/class/leds/blue:status"
+#endif
+
+#ifndef PLATFORM_DEFAULT_GPIO_CHIP
+#define PLATFORM_DEFAULT_GPIO_CHIP  "/dev/gpiochip0"
+#endif
+
+#ifndef PLATFORM_DEFAULT_BUTTON_LINE
+#define PLATFORM_DEFAULT_BUTTON_LINE 0
+#endif
+
+#ifndef PLATFORM_DEFAULT_BUTTON_ACTIVE_LOW
+#define PLATFORM_DEFAULT_BUTTON_ACTIVE_LOW 1
+#endif
+
+#ifndef PLATFORM_DEFAULT_VPN_INTERFACE
+#define PLATFORM_DEFAULT_VPN_INTERFACE "wg0"
+#endif
+
+#ifndef PLATFORM_DEFAULT_CEC_DEVICE
+#define PLATFORM_DEFAULT_CEC_DEVICE "/dev/cec0"
+#endif
+
+#ifndef PLATFORM_DEFAULT_PS5_CEC_ADDR
+#define PLATFORM_DEFAULT_PS5_CEC_ADDR 4  /* CEC_LOG_ADDR_PLAYBACK_1 */
+#endif
+
+/* ============================================================================
+ * Blob 佈局
+ * ========================================================================== */
+
+typedef struct {
+    uint32_t magic;          /**< PLATFORM_CONFIG_MAGIC */
+    uint16_t version;        /**< PLATFORM_CONFIG_VERSION */
+    uint16_t header_size;    /**< sizeof(platform_config_header_t) */
+    uint32_t size;           /**< 整個 blob 大小，等於 sizeof(platform_config_t) */
+    uint32_t crc32;          /**< 標頭之後所有內容的 CRC32 */
+    uint32_t generation;     /**< 每次重新編譯遞增，用於日誌 */
+    uint32_t reserved;
+} platform_config_header_t;
+
+typedef struct {
+    platform_config_header_t header;
+
+    /* LED（sysfs LED class 目錄） */
+    char led_red[PLATFORM_CONFIG_PATH_MAX];
+    char led_green[PLATFORM_CONFIG_PATH_MAX];
+    char led_blue[PLATFORM_CONFIG_PATH_MAX];
+    char vpn_interface[PLATFORM_CONFIG_IFNAME_MAX];  /**< LED_STATE_VPN_TRAFFIC 的 netdev trigger 介面 */
+
+    /* 按鈕（GPIO chardev） */
+    char gpio_chip[PLATFORM_CONFIG_PATH_MAX];
+    uint32_t button_count;
+    uint32_t button_lines[PLATFORM_CONFIG_MAX_BUTTONS];  /**< 索引即按鈕編號 */
+    uint32_t button_active_low;                          /**< 按下時線路為低電位 */
+
+    /* GPIO 暫存器直接存取（低延遲模式，gpio_mmio_path 為空字串時停用） */
+    char gpio_mmio_path[PLATFORM_CONFIG_PATH_MAX];  /**< /dev/uioN、/dev/mem 或測試用暫存器映像檔 */
+    uint32_t gpio_mmio_offset;      /**< mmap 偏移（/dev/mem 為實體位址），需頁對齊 */
+    uint32_t gpio_mmio_size;        /**< 映射大小 */
+    uint32_t mmio_din_reg;          /**< 輸入資料暫存器偏移 */
+    uint32_t mmio_dout_reg;         /**< 輸出資料暫存器偏移 */
+    uint32_t mmio_dout_set_reg;     /**< 寫 1 設定的暫存器偏移，或 PLATFORM_CONFIG_NO_REG */
+    uint32_t mmio_dout_clr_reg;     /**< 寫 1 清除的暫存器偏移，或 PLATFORM_CONFIG_NO_REG */
+    uint32_t mmio_button_bits[PLATFORM_CONFIG_MAX_BUTTONS];  /**< 各按鈕在 DIN 的位元 */
+    uint32_t mmio_led_bits[PLATFORM_CONFIG_LED_CHANNELS];   /**< R/G/B 在 DOUT 的位元 */
+    uint32_t mmio_led_active_low;   /**< 輸出低電位時 LED 亮 */
+
+    /* PS5（HDMI-CEC） */
+    char cec_device[PLATFORM_CONFIG_PATH_MAX];
+    uint32_t ps5_cec_addr;
+
+    /* 策略覆寫，0 表示使用校準結果 */
+    uint32_t cache_ttl_ms;
+    uint32_t poll_min_ms;
+    uint32_t poll_max_ms;
+    uint32_t cec_timeout_ms;
+    uint32_t ps5_reply_timeout_ms;
+} platform_config_t;
+
+/**
+ * @brief CRC32（IEEE 802.3），逐位元計算
+ *
+ * blob 只在載入時驗證一次，不需要查表版本。
+ */
+static inline uint32_t platform_config_crc32(const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief 計算 blob 內容（標頭之後）的 CRC32
+ */
+static inline uint32_t platform_config_checksum(const platform_config_t *cfg) {
+    return platform_config_crc32((const uint8_t *)cfg + sizeof(cfg->header),
+                                 sizeof(*cfg) - sizeof(cfg->header));
+}
+
+/**
+ * @brief 填入預設配置（含有效的標頭）
+ */
+static inline void platform_config_defaults(platform_config_t *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    strncpy(cfg->led_red, PLATFORM_DEFAULT_LED_RED, PLATFORM_CONFIG_PATH_MAX - 1);
+    strncpy(cfg->led_green, PLATFORM_DEFAULT_LED_GREEN, PLATFORM_CONFIG_PATH_MAX - 1);
+    strncpy(cfg->led_blue, PLATFORM_DEFAULT_LED_BLUE, PLATFORM_CONFIG_PATH_MAX - 1);
+    strncpy(cfg->vpn_interface, PLATFORM_DEFAULT_VPN_INTERFACE, PLATFORM_CONFIG_IFNAME_MAX - 1);
+    strncpy(cfg->gpio_chip, PLATFORM_DEFAULT_GPIO_CHIP, PLATFORM_CONFIG_PATH_MAX - 1);
+    cfg->button_count = 1;
+    cfg->button_lines[0] = PLATFORM_DEFAULT_BUTTON_LINE;
+    cfg->button_active_low = PLATFORM_DEFAULT_BUTTON_ACTIVE_LOW;
+    strncpy(cfg->cec_device, PLATFORM_DEFAULT_CEC_DEVICE, PLATFORM_CONFIG_PATH_MAX - 1);
+    cfg->ps5_cec_addr = PLATFORM_DEFAULT_PS5_CEC_ADDR;
+    cfg->mmio_dout_set_reg = PLATFORM_CONFIG_NO_REG;
+    cfg->mmio_dout_clr_reg = PLATFORM_CONFIG_NO_REG;
+
+    cfg->header.magic = PLATFORM_CONFIG_MAGIC;
+    cfg->header.version = PLATFORM_CONFIG_VERSION;
+    cfg->header.header_size = sizeof(cfg->header);
+    cfg->header.size = sizeof(*cfg);
+    cfg->header.crc32 = platform_config_checksum(cfg);
+}
+
+#endif /* PLATFORM_CONFIG_H */
@@ -0,0 +1,337 @@
+/**
+ * @file platform_config_compile.c
+ * @brief UCI 配置編譯工具（gaming-platform-config）
+ *
+ * 讀取 /etc/config/gaming-platform，驗證所有選項後寫出 config blob。
+ * 驗證失敗時不會覆蓋現有 blob，執行中的行程繼續使用舊配置。
+ *
+ * 用法:
+ *   gaming-platform-config [-c confdir] [-o output]
+ *
+ * - -c: UCI 配置目錄（預設 /etc/config，測試時可指向本地目錄）
+ * - -o: 輸出路徑（預設 PLATFORM_CONFIG_BLOB_PATH）
+ *
+ * blob 先寫入暫存檔再 rename，讀取端只會看到完整的新檔或舊檔。
+ */
+
+#include "platform_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <uci.h>
+
+#define UCI_PACKAGE "gaming-platform"
+#define MAX_GPIO_LINE 1023
+
+static int g_errors;
+
+static void config_error(const char *option, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void config_error(const char *option, const char *format, ...) {
+    va_list args;
+    fprintf(stderr, "[gaming-platform-config] %s: ", option);
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+    g_errors++;
+}
+
+/**
+ * @brief 解析無號整數選項
+ *
+ * 未設定時保留 *out 原值（預設值）。
+ */
+static void parse_uint(struct uci_context *ctx, struct uci_section *s,
+                       const char *option, uint32_t min, uint32_t max,
+                       uint32_t *out) {
+    const char *value = s ? uci_lookup_option_string(ctx, s, option) : NULL;
+    char *end;
+
+    if (!value) {
+        return;
+    }
+
+    errno = 0;
+    unsigned long v = strtoul(value, &end, 0);
+    if (errno || end == value || *end != '\0' || v < min || v > max) {
+        config_error(option, "'%s' is not an integer in [%u, %u]", value, min, max);
+        return;
+    }
+    *out = (uint32_t)v;
+}
+
+/**
+ * @brief 解析絕對路徑選項
+ */
+static void parse_path(struct uci_context *ctx, struct uci_section *s,
+                       const char *option, char out[PLATFORM_CONFIG_PATH_MAX]) {
+    const char *value = s ? uci_lookup_option_string(ctx, s, option) : NULL;
+
+    if (!value) {
+        return;
+    }
+    if (value[0] != '/') {
+        config_error(option, "'%s' is not an absolute path", value);
+        return;
+    }
+    if (strlen(value) >= PLATFORM_CONFIG_PATH_MAX) {
+        config_error(option, "path longer than %d bytes", PLATFORM_CONFIG_PATH_MAX - 1);
+        return;
+    }
+    memset(out, 0, PLATFORM_CONFIG_PATH_MAX);
+    strcpy(out, value);
+}
+
+/**
+ * @brief 解析網路介面名稱選項
+ */
+static void parse_ifname(struct uci_context *ctx, struct uci_section *s,
+                         const char *option, char out[PLATFORM_CONFIG_IFNAME_MAX]) {
+    const char *value = s ? uci_lookup_option_string(ctx, s, option) : NULL;
+
+    if (!value) {
+        return;
+    }
+    if (value[0] == '\0' || strlen(value) >= PLATFORM_CONFIG_IFNAME_MAX) {
+        config_error(option, "interface name must be 1-%d bytes", PLATFORM_CONFIG_IFNAME_MAX - 1);
+        return;
+    }
+    if (strpbrk(value, "/: \t") || strcmp(value, ".") == 0 || strcmp(value, "..") == 0) {
+        config_error(option, "'%s' is not a valid interface name", value);
+        return;
+    }
+    memset(out, 0, PLATFORM_CONFIG_IFNAME_MAX);
+    strcpy(out, value);
+}
+
+/**
+ * @brief 解析整數清單選項（UCI list，單一值的 option 亦可）
+ *
+ * @return 解析出的項目數；未設定時返回 0 且不修改 out
+ */
+static uint32_t parse_uint_list(struct uci_context *ctx, struct uci_section *s,
+                                const char *option, uint32_t max,
+                                uint32_t *out, uint32_t capacity) {
+    struct uci_option *o = s ? uci_lookup_option(ctx, s, option) : NULL;
+    struct uci_element *e;
+    uint32_t count = 0;
+
+    if (!o) {
+        return 0;
+    }
+    if (o->type == UCI_TYPE_STRING) {
+        parse_uint(ctx, s, option, 0, max, &out[0]);
+        return 1;
+    }
+
+    uci_foreach_element(&o->v.list, e) {
+        char *end;
+        unsigned long v = strtoul(e->name, &end, 0);
+
+        if (count >= capacity) {
+            config_error(option, "at most %u values are supported", capacity);
+            return count;
+        }
+        if (end == e->name || *end != '\0' || v > max) {
+            config_error(option, "'%s' is not an integer in [0, %u]", e->name, max);
+            return count;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            if (out[i] == v) {
+                config_error(option, "%lu listed twice", v);
+                return count;
+            }
+        }
+        out[count++] = (uint32_t)v;
+    }
+    return count;
+}
+
+/**
+ * @brief 解析 GPIO 暫存器直接存取設定
+ *
+ * 只在設定 gpio_mmio_path 時檢查，所有暫存器必須在映射範圍內且 4 位元組對齊。
+ */
+static void parse_mmio(struct uci_context *ctx, struct uci_section *s,
+                       platform_config_t *cfg) {
+    const uint32_t regs_max = 0x100000;
+
+    parse_path(ctx, s, "gpio_mmio_path", cfg->gpio_mmio_path);
+    if (cfg->gpio_mmio_path[0] == '\0') {
+        return;
+    }
+
+    parse_uint(ctx, s, "gpio_mmio_offset", 0, UINT32_MAX, &cfg->gpio_mmio_offset);
+    parse_uint(ctx, s, "gpio_mmio_size", 4, regs_max, &cfg->gpio_mmio_size);
+    parse_uint(ctx, s, "mmio_din_reg", 0, regs_max, &cfg->mmio_din_reg);
+    parse_uint(ctx, s, "mmio_dout_reg", 0, regs_max, &cfg->mmio_dout_reg);
+    parse_uint(ctx, s, "mmio_dout_set_reg", 0, regs_max, &cfg->mmio_dout_set_reg);
+    parse_uint(ctx, s, "mmio_dout_clr_reg", 0, regs_max, &cfg->mmio_dout_clr_reg);
+    parse_uint(ctx, s, "mmio_led_active_low", 0, 1, &cfg->mmio_led_active_low);
+
+    if (cfg->gpio_mmio_offset % 4096) {
+        config_error("gpio_mmio_offset", "must be page aligned");
+    }
+
+    const struct { const char *name; uint32_t reg; } regs[] = {
+        { "mmio_din_reg", cfg->mmio_din_reg },
+        { "mmio_dout_reg", cfg->mmio_dout_reg },
+        { "mmio_dout_set_reg", cfg->mmio_dout_set_reg },
+        { "mmio_dout_clr_reg", cfg->mmio_dout_clr_reg },
+    };
+    for (size_t i = 0; i < sizeof(regs) / sizeof(regs[0]); i++) {
+        if (regs[i].reg == PLATFORM_CONFIG_NO_REG) {
+            continue;
+        }
+        if (regs[i].reg % 4 || regs[i].reg + 4 > cfg->gpio_mmio_size) {
+            config_error(regs[i].name, "0x%x is unaligned or outside gpio_mmio_size",
+                         regs[i].reg);
+        }
+    }
+    if ((cfg->mmio_dout_set_reg == PLATFORM_CONFIG_NO_REG) !=
+        (cfg->mmio_dout_clr_reg == PLATFORM_CONFIG_NO_REG)) {
+        config_error("mmio_dout_set_reg", "set and clear registers must be given together");
+    }
+
+    if (parse_uint_list(ctx, s, "mmio_button_bit", 31, cfg->mmio_button_bits,
+                        PLATFORM_CONFIG_MAX_BUTTONS) != cfg->button_count) {
+        config_error("mmio_button_bit", "need one bit per button_line (%u)",
+                     cfg->button_count);
+    }
+    if (parse_uint_list(ctx, s, "mmio_led_bit", 31, cfg->mmio_led_bits,
+                        PLATFORM_CONFIG_LED_CHANNELS) != PLATFORM_CONFIG_LED_CHANNELS) {
+        config_error("mmio_led_bit", "need exactly %d bits (red, green, blue)",
+                     PLATFORM_CONFIG_LED_CHANNELS);
+    }
+}
+
+static int write_blob(const char *path, platform_config_t *cfg) {
+    char tmp_path[256];
+    char dir[256];
+    platform_config_header_t old;
+
+    // 沿用舊 blob 的 generation 遞增，方便從日誌判斷各行程使用哪一版
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        if (read(fd, &old, sizeof(old)) == (ssize_t)sizeof(old) &&
+            old.magic == PLATFORM_CONFIG_MAGIC) {
+            cfg->header.generation = old.generation + 1;
+        }
+        close(fd);
+    }
+    cfg->header.crc32 = platform_config_checksum(cfg);
+
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (slash && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "[gaming-platform-config] %s: %s\n", tmp_path, strerror(errno));
+        return -1;
+    }
+    if (write(fd, cfg, sizeof(*cfg)) != (ssize_t)sizeof(*cfg) || fsync(fd) != 0) {
+        fprintf(stderr, "[gaming-platform-config] %s: %s\n", tmp_path, strerror(errno));
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+    close(fd);
+
+    if (rename(tmp_path, path) != 0) {
+        fprintf(stderr, "[gaming-platform-config] %s: %s\n", path, strerror(errno));
+        unlink(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *confdir = NULL;
+    const char *output = PLATFORM_CONFIG_BLOB_PATH;
+    struct uci_package *pkg = NULL;
+    platform_config_t cfg;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:o:")) != -1) {
+        switch (opt) {
+            case 'c': confdir = optarg; break;
+            case 'o': output = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-c confdir] [-o output]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    struct uci_context *ctx = uci_alloc_context();
+    if (!ctx) {
+        fprintf(stderr, "[gaming-platform-config] out of memory\n");
+        return 1;
+    }
+    if (confdir) {
+        uci_set_confdir(ctx, confdir);
+    }
+    if (uci_load(ctx, UCI_PACKAGE, &pkg) != UCI_OK) {
+        uci_perror(ctx, "[gaming-platform-config] " UCI_PACKAGE);
+        uci_free_context(ctx);
+        return 1;
+    }
+
+    platform_config_defaults(&cfg);
+
+    struct uci_section *main_s = uci_lookup_section(ctx, pkg, "main");
+    parse_path(ctx, main_s, "led_red", cfg.led_red);
+    parse_path(ctx, main_s, "led_green", cfg.led_green);
+    parse_path(ctx, main_s, "led_blue", cfg.led_blue);
+    parse_ifname(ctx, main_s, "vpn_interface", cfg.vpn_interface);
+    parse_path(ctx, main_s, "gpio_chip", cfg.gpio_chip);
+    uint32_t buttons = parse_uint_list(ctx, main_s, "button_line", MAX_GPIO_LINE,
+                                       cfg.button_lines, PLATFORM_CONFIG_MAX_BUTTONS);
+    if (buttons) {
+        cfg.button_count = buttons;
+    }
+    parse_uint(ctx, main_s, "button_active_low", 0, 1, &cfg.button_active_low);
+    parse_path(ctx, main_s, "cec_device", cfg.cec_device);
+    parse_uint(ctx, main_s, "ps5_cec_addr", 0, 14, &cfg.ps5_cec_addr);
+
+    parse_mmio(ctx, uci_lookup_section(ctx, pkg, "mmio"), &cfg);
+
+    struct uci_section *policy_s = uci_lookup_section(ctx, pkg, "policy");
+    parse_uint(ctx, policy_s, "cache_ttl_ms", 0, 60000, &cfg.cache_ttl_ms);
+    parse_uint(ctx, policy_s, "poll_min_ms", 0, 1000, &cfg.poll_min_ms);
+    parse_uint(ctx, policy_s, "poll_max_ms", 0, 10000, &cfg.poll_max_ms);
+    parse_uint(ctx, policy_s, "cec_timeout_ms", 0, 10000, &cfg.cec_timeout_ms);
+    parse_uint(ctx, policy_s, "ps5_reply_timeout_ms", 0, 10000, &cfg.ps5_reply_timeout_ms);
+
+    if (cfg.poll_min_ms && cfg.poll_max_ms && cfg.poll_min_ms > cfg.poll_max_ms) {
+        config_error("poll_min_ms", "greater than poll_max_ms");
+    }
+
+    uci_unload(ctx, pkg);
+    uci_free_context(ctx);
+
+    if (g_errors) {
+        fprintf(stderr, "[gaming-platform-config] %d error(s), %s not updated\n",
+                g_errors, output);
+        return 1;
+    }
+
+    if (write_blob(output, &cfg) != 0) {
+        return 1;
+    }
+
+    printf("[gaming-platform-config] Wrote %s (generation %u, %zu bytes)\n",
+           output, cfg.header.generation, sizeof(cfg));
+    return 0;
+}
@@ -29,6 +29,36 @@ extern "C" {
 #define PLATFORM_ERROR_PARAM    -3
 #define PLATFORM_ERROR_TIMEOUT  -4
 #define PLATFORM_ERROR_NOT_FOUND -5
+#define PLATFORM_ERROR_BUSY     -6  /**< 資源被其他行程獨佔（例如按鈕線路） */
+
+/* ============================================================================
+ * 功能選擇
+ * ========================================================================== */
+
+/**
+ * 變體套件以編譯期開關移除不使用的子系統：
+ * - gaming-platform-client：PLATFORM_FEATURE_PS5=0（無 PS5 電源 / CEC）
+ * - gaming-platform-server：PLATFORM_FEATURE_BUTTON=0（無按鈕）
+ *
+ * 套件安裝的 platform_features.h 記錄該變體的開關，應用層只要包含本標頭檔，
+ * 對已移除子系統的調用就會展開為常數（static inline 樁函數），
+ * 不產生函數調用也不連結到實作。
+ *
+ * 函式庫本身仍匯出這些函數（返回相同常數），以維持 ABI 相容。
+ */
+#if defined(__has_include)
+#if __has_include("platform_features.h")
+#include "platform_features.h"
+#endif
+#endif
+
+#ifndef PLATFORM_FEATURE_PS5
+#define PLATFORM_FEATURE_PS5 1
+#endif
+
+#ifndef PLATFORM_FEATURE_BUTTON
+#define PLATFORM_FEATURE_BUTTON 1
+#endif
 
 /* ============================================================================
  * 1. 系統初始化與清理
@@ -55,7 +85,7 @@ void platform_cleanup(void);
 /**
  * @brief 獲取 Platform 實作版本
  *
- * @return 版本字串，例如 "OpenWrt-ADC-v1.0" 或 "Mock-v1.0"
+ * @return 版本字串，例如 "OpenWrt-v1.0.0"（變體套件加上 "-client" / "-server"）或 "Mock-v1.0.0"
  *
  * @note 用於調試和日誌記錄
  */
@@ -112,6 +142,7 @@ typedef enum {
     LED_STATE_ERROR,             /**< 一般錯誤（建議：紅色） */
     LED_STATE_SYSTEM_ERROR,      /**< 系統錯誤（建議：紅色快閃） */
     LED_STATE_SYSTEM_STARTUP,    /**< 系統啟動中（建議：黃色） */
+    LED_STATE_VPN_TRAFFIC,       /**< VPN 流量指示（建議：沿用目前顏色，隨隧道流量閃爍） */
 } platform_led_state_t;
 
 /**
@@ -128,6 +159,36 @@ typedef enum {
  */
 int platform_set_led_state(platform_led_state_t state);
 
+/**
+ * @brief 設定 LED 狀態並回報到延遲 span
+ *
+ * @param state LED 狀態
+ * @param span_id 按鈕事件的 span_id，PLATFORM_SPAN_NONE 時等同 platform_set_led_state()
+ * @return 同 platform_set_led_state()
+ *
+ * @note VPN_CONNECTED / VPN_TRAFFIC 與 PS5_ON 為 span 的兩個確認點，
+ *       兩者都出現後 span 結束；錯誤狀態中止 span；其他狀態只延續 span。
+ *       見第 8 節「延遲統計」。
+ */
+int platform_set_led_state_span(platform_led_state_t state, uint32_t span_id);
+
+/**
+ * @brief 結束 VPN 流量指示，恢復進入前的 LED 狀態
+ *
+ * @return PLATFORM_OK 成功（未在流量指示中時不做任何事），其他值失敗
+ *
+ * @note LED_STATE_VPN_TRAFFIC 把 LED 交給核心 netdev trigger，
+ *       依配置的隧道介面（rx / tx / link）閃爍，期間不佔用使用者空間 CPU。
+ *       閃爍顏色沿用進入前的恆亮顏色（沒有時為綠色）。
+ *       直接設定其他狀態或顏色同樣會結束流量指示。
+ *
+ * @example
+ *   platform_set_led_state(LED_STATE_VPN_CONNECTED);  // 綠色
+ *   platform_set_led_state(LED_STATE_VPN_TRAFFIC);    // 綠色，隨流量閃爍
+ *   platform_clear_led_traffic();                     // 恢復恆亮綠色
+ */
+int platform_clear_led_traffic(void);
+
 /**
  * @brief 自定義 LED 顏色（可選功能）
  *
@@ -140,6 +201,30 @@ int platform_set_led_state(platform_led_state_t state);
  */
 int platform_set_led_rgb(uint8_t r, uint8_t g, uint8_t b);
 
+/**
+ * @brief 目前 LED 狀態
+ */
+typedef struct {
+    platform_led_state_t state;  /**< 最後設定的 LED 狀態（custom 時無意義） */
+    bool custom;                 /**< 由 platform_set_led_rgb() 設定的自定義顏色 */
+    uint8_t r, g, b;             /**< 目前顏色（閃爍時為亮的顏色） */
+} platform_led_info_t;
+
+/**
+ * @brief 獲取目前 LED 狀態
+ *
+ * @param info 輸出
+ * @return PLATFORM_OK 成功，PLATFORM_ERROR_PARAM 參數錯誤
+ *
+ * @note 反映本行程經由硬體層套用的結果，包括 platform_clear_led_traffic() 恢復的狀態，
+ *       本行程不必另外保存一份
+ *
+ * @note 狀態記錄在每個行程各自的硬體層中，不會從 sysfs 讀回。
+ *       其他行程調用 platform_set_led() 等的變更不會反映在這裡，也沒有通知；
+ *       需要跨行程的 LED 狀態時，應統一經由 gaming-platformd 設定 LED。
+ */
+int platform_get_led(platform_led_info_t *info);
+
 /* ============================================================================
  * 4. 按鈕狀態
  * ========================================================================== */
@@ -150,6 +235,7 @@ int platform_set_led_rgb(uint8_t r, uint8_t g, uint8_t b);
 typedef enum {
     BUTTON_RELEASED = 0,  /**< 按鈕未按下 */
     BUTTON_PRESSED = 1,   /**< 按鈕已按下 */
+    BUTTON_UNAVAILABLE = 2, /**< 無法讀取，原因見 platform_get_last_error() */
 } platform_button_state_t;
 
 /**
@@ -157,7 +243,10 @@ typedef enum {
  *
  * 應用層（gaming-client）會持續輪詢此函數來檢測按鈕按下。
  *
- * @return BUTTON_PRESSED 或 BUTTON_RELEASED
+ * @return BUTTON_PRESSED 或 BUTTON_RELEASED；
+ *         讀取失敗（例如按鈕線路被其他行程持有）時返回 BUTTON_UNAVAILABLE
+ *
+ * @note 按鈕線路同一時間只有一個擁有者，見 platform_get_buttons()。
  *
  * @note 內部實作可使用任何方式：
  *       - 讀取 GPIO
@@ -175,7 +264,128 @@ typedef enum {
  *       vpn_controller_connect();
  *   }
  */
+#if PLATFORM_FEATURE_BUTTON || defined(PLATFORM_IMPLEMENTATION)
 platform_button_state_t platform_get_button_state(void);
+#else
+static inline platform_button_state_t platform_get_button_state(void) {
+    return BUTTON_RELEASED;
+}
+#endif
+
+/**
+ * @brief 按鈕編號（platform_get_buttons() 位元遮罩中的位元位置）
+ *
+ * 實際接線由配置檔的 button_line 清單依序決定。
+ */
+#define PLATFORM_BUTTON_MAIN     0  /**< 主按鈕（platform_get_button_state() 讀取的按鈕） */
+#define PLATFORM_BUTTON_PAIRING  1  /**< 配對鍵 */
+#define PLATFORM_BUTTON_MODE     2  /**< 模式鍵 */
+
+/**
+ * @brief 按鈕邊緣事件
+ */
+typedef struct {
+    uint32_t button;                /**< 按鈕編號（PLATFORM_BUTTON_*） */
+    platform_button_state_t state;  /**< 事件後的狀態 */
+    uint64_t timestamp_ns;          /**< 核心記錄的事件時間（CLOCK_MONOTONIC） */
+    uint32_t span_id;               /**< 主按鈕按下開啟的延遲 span，放開沿用同一次按下的 span；其他按鈕為 PLATFORM_SPAN_NONE（見第 8 節） */
+} platform_button_event_t;
+
+/**
+ * @brief 同時讀取所有按鈕
+ *
+ * @param mask 輸出：位元 n 為 1 表示按鈕 n 按下
+ * @return PLATFORM_OK 成功，
+ *         PLATFORM_ERROR_BUSY 按鈕線路被其他行程持有，
+ *         其他值失敗（*mask 為 0）
+ *
+ * @note 所有按鈕在同一次取樣中讀出（單一 ioctl），
+ *       不會出現兩個按鈕分別在不同時間點取樣的情況
+ *
+ * @note 單一擁有者：GPIO chardev 的 line request 是獨佔的。
+ *       第一次讀取時取得線路並保持到 platform_release_buttons() / platform_cleanup()，
+ *       期間其他行程的讀取返回 PLATFORM_ERROR_BUSY（platform_get_button_state()
+ *       返回 BUTTON_UNAVAILABLE）。系統上應只有一個行程讀取按鈕：
+ *       gaming-client 輪詢，或 gaming-platformd -b 以 button 通知轉發；
+ *       停止讀取的行程應調用 platform_release_buttons()。
+ *       使用 gpio_mmio_path 時以暫存器讀取，不佔用線路。
+ *
+ * @example
+ *   uint32_t mask;
+ *   if (platform_get_buttons(&mask) == PLATFORM_OK &&
+ *       (mask & (1u << PLATFORM_BUTTON_PAIRING))) {
+ *       // 配對鍵按下
+ *   }
+ */
+#if PLATFORM_FEATURE_BUTTON || defined(PLATFORM_IMPLEMENTATION)
+int platform_get_buttons(uint32_t *mask);
+#else
+static inline int platform_get_buttons(uint32_t *mask) {
+    if (mask) *mask = 0;
+    return PLATFORM_OK;
+}
+#endif
+
+/**
+ * @brief 獲取按鈕事件的檔案描述符
+ *
+ * 返回的 fd 可交給 poll()/epoll 等待按鈕事件，可讀時調用
+ * platform_read_button_event() 取出事件。首次調用時才啟用邊緣偵測。
+ *
+ * @return 檔案描述符，失敗返回 -1
+ *
+ * @note fd 由硬體層擁有，應用層不可關閉；
+ *       platform_reset()、platform_release_buttons() 或 platform_cleanup() 後失效，需重新取得
+ *
+ * @note 事件需要 chardev 線路，即使使用 gpio_mmio_path 也會佔用線路（單一擁有者，
+ *       見 platform_get_buttons()）。不再需要事件時應調用 platform_release_buttons()。
+ */
+#if PLATFORM_FEATURE_BUTTON || defined(PLATFORM_IMPLEMENTATION)
+int platform_get_button_fd(void);
+#else
+static inline int platform_get_button_fd(void) {
+    return -1;
+}
+#endif
+
+/**
+ * @brief 釋放按鈕線路，讓其他行程可以讀取按鈕
+ *
+ * 之後的按鈕讀取或 platform_get_button_fd() 會自動重新取得線路。
+ * 釋放期間發生的按鈕事件不會被記錄。
+ */
+#if PLATFORM_FEATURE_BUTTON || defined(PLATFORM_IMPLEMENTATION)
+void platform_release_buttons(void);
+#else
+static inline void platform_release_buttons(void) {
+}
+#endif
+
+/**
+ * @brief 讀取一個按鈕事件（非阻塞）
+ *
+ * @param event 輸出事件
+ * @return PLATFORM_OK 讀到事件，
+ *         PLATFORM_ERROR_NOT_FOUND 目前沒有事件，
+ *         其他值失敗
+ *
+ * @example
+ *   struct pollfd pfd = { .fd = platform_get_button_fd(), .events = POLLIN };
+ *   while (poll(&pfd, 1, -1) > 0) {
+ *       platform_button_event_t ev;
+ *       while (platform_read_button_event(&ev) == PLATFORM_OK) {
+ *           // 處理 ev.button / ev.state
+ *       }
+ *   }
+ */
+#if PLATFORM_FEATURE_BUTTON || defined(PLATFORM_IMPLEMENTATION)
+int platform_read_button_event(platform_button_event_t *event);
+#else
+static inline int platform_read_button_event(platform_button_event_t *event) {
+    (void)event;
+    return PLATFORM_ERROR_NOT_FOUND;
+}
+#endif
 
 /* ============================================================================
  * 5. PS5 電源狀態與控制
@@ -214,7 +424,13 @@ typedef enum {
  *       platform_set_led_state(LED_STATE_PS5_ON);
  *   }
  */
+#if PLATFORM_FEATURE_PS5 || defined(PLATFORM_IMPLEMENTATION)
 platform_ps5_power_t platform_get_ps5_power(void);
+#else
+static inline platform_ps5_power_t platform_get_ps5_power(void) {
+    return PLATFORM_PS5_UNKNOWN;
+}
+#endif
 
 /**
  * @brief 喚醒 PS5
@@ -242,7 +458,30 @@ platform_ps5_power_t platform_get_ps5_power(void);
  *       }
  *   }
  */
+#if PLATFORM_FEATURE_PS5 || defined(PLATFORM_IMPLEMENTATION)
 int platform_send_ps5_wake(void);
+#else
+static inline int platform_send_ps5_wake(void) {
+    return PLATFORM_ERROR_NOT_FOUND;
+}
+#endif
+
+/**
+ * @brief 發送 PS5 喚醒命令並回報到延遲 span
+ *
+ * @param span_id 按鈕事件的 span_id，PLATFORM_SPAN_NONE 時等同 platform_send_ps5_wake()
+ * @return 同 platform_send_ps5_wake()
+ *
+ * @note 成功送出時記錄「按下 → 喚醒」一段，並作為「喚醒 → PS5 開機」一段的起點
+ */
+#if PLATFORM_FEATURE_PS5 || defined(PLATFORM_IMPLEMENTATION)
+int platform_send_ps5_wake_span(uint32_t span_id);
+#else
+static inline int platform_send_ps5_wake_span(uint32_t span_id) {
+    (void)span_id;
+    return PLATFORM_ERROR_NOT_FOUND;
+}
+#endif
 
 /* ============================================================================
  * 6. 錯誤處理與調試
@@ -261,11 +500,140 @@ const char* platform_get_last_error(void);
  * @brief 重置硬體層（可選功能）
  *
  * 當檢測到錯誤時，應用層可調用此函數嘗試恢復。
+ * 依目前配置重新開啟按鈕線路、MMIO 與 CEC 裝置。
  *
  * @return PLATFORM_OK 成功，其他值失敗
+ *
+ * @note 配置更新後 LED、VPN 介面與逾時等策略自動生效；
+ *       gpio_chip、button_line、gpio_mmio_*、cec_device 需調用此函數才會套用
  */
 int platform_reset(void);
 
+/* ============================================================================
+ * 7. 硬體校準
+ * ========================================================================== */
+
+/**
+ * @brief 硬體校準結果
+ *
+ * 前半部為實際量測值（微秒），0 表示該項未量測（硬體不存在或量測失敗）。
+ * 後半部為依量測值推導出的執行策略，未量測項目使用預設值。
+ */
+typedef struct {
+    /* 量測值 */
+    uint32_t sysfs_write_us;        /**< LED sysfs 寫入延遲 */
+    uint32_t gpio_read_us;          /**< 按鈕 GPIO 讀取延遲 */
+    uint32_t cec_rtt_us;            /**< CEC 單一訊框來回時間（含 ACK） */
+    uint32_t ps5_response_us;       /**< PS5 回應電源狀態查詢的時間 */
+
+    /* 推導策略 */
+    uint32_t cache_ttl_ms;          /**< PS5 電源狀態快取有效時間 */
+    uint32_t poll_min_ms;           /**< 自適應輪詢間隔下限 */
+    uint32_t poll_max_ms;           /**< 自適應輪詢間隔上限 */
+    uint32_t cec_timeout_ms;        /**< CEC 傳送逾時 */
+    uint32_t ps5_reply_timeout_ms;  /**< 等待 PS5 回覆的逾時 */
+} platform_calibration_t;
+
+/**
+ * @brief 量測硬體延遲並更新執行策略
+ *
+ * 依序量測 LED sysfs 寫入、按鈕 GPIO 讀取、CEC 來回時間與 PS5 回應時間，
+ * 推導快取 TTL、輪詢間隔上下限與逾時設定，並將量測結果持久化保存。
+ *
+ * @return PLATFORM_OK 至少一項量測成功，
+ *         PLATFORM_ERROR_NOT_FOUND 所有量測皆失敗（策略維持預設值）
+ *
+ * @note platform_init() 在沒有已保存的校準結果時會自動執行一次，
+ *       之後的開機直接載入保存結果。更換硬體後可手動調用以重新校準。
+ *
+ * @note CEC 量測會在匯流排上發送訊框，耗時約數百毫秒
+ */
+int platform_calibrate(void);
+
+/**
+ * @brief 獲取目前的校準結果與執行策略
+ *
+ * @param out 輸出結果
+ * @return PLATFORM_OK 成功，PLATFORM_ERROR_PARAM 參數為 NULL
+ *
+ * @note 應用層的輪詢迴圈應使用 poll_min_ms / poll_max_ms 作為間隔範圍，
+ *       而非寫死的 sleep 值
+ *
+ * @example
+ *   platform_calibration_t cal;
+ *   platform_get_calibration(&cal);
+ *   usleep(cal.poll_min_ms * 1000);
+ */
+int platform_get_calibration(platform_calibration_t *out);
+
+/* ============================================================================
+ * 8. 延遲統計
+ * ========================================================================== */
+
+/**
+ * 使用者感受到的延遲是「按下按鈕 → LED 顯示 VPN 已連線且 PS5 已開機」。
+ * 每次按下主按鈕（PLATFORM_BUTTON_MAIN）開啟一個 span（platform_button_event_t.span_id），
+ * 之後帶著 span_id 的 platform_set_led_state_span() / platform_send_ps5_wake_span()
+ * 延續或結束該 span。HAL 記錄整段與各段的延遲分布。
+ *
+ * 起點使用核心記錄的按鈕事件時間，包含應用層讀取事件前的排程延遲。
+ * 按鈕線路設定核心去彈跳，距上次邊緣 50ms 內的按下另外視為彈跳，沿用同一個 span。
+ *
+ * 限制：span 只存在於讀取按鈕事件的行程內，span_id 不能跨行程使用，
+ * 其他行程傳入的 span_id 會被忽略。經由 gaming-platformd 時，span_id 來自它的 button 通知，
+ * set_led / ps5_wake 也在同一行程執行，因此可以完整記錄。
+ *   - 完整版（full）：同一行程讀取按鈕並控制 LED / PS5，可記錄所有段落
+ *   - client：沒有 PS5 功能，只記錄 VPN 段，TOTAL / WAKE / PS5 不會有樣本
+ *   - server：沒有按鈕，不會開啟 span，統計恆為 0
+ */
+
+#define PLATFORM_SPAN_NONE 0  /**< 不屬於任何 span */
+
+/**
+ * @brief span 的段落
+ */
+typedef enum {
+    PLATFORM_SPAN_TOTAL = 0,    /**< 按下 → VPN 已連線且 PS5 開機（兩個確認點都出現） */
+    PLATFORM_SPAN_VPN,          /**< 按下 → LED 顯示 VPN 已連線 */
+    PLATFORM_SPAN_WAKE,         /**< 按下 → PS5 喚醒命令送出 */
+    PLATFORM_SPAN_PS5,          /**< 喚醒命令送出 → LED 顯示 PS5 開機 */
+    PLATFORM_SPAN_LEG_COUNT,
+} platform_span_leg_t;
+
+/**
+ * @brief 單一段落的延遲分布（微秒）
+ *
+ * 百分位數取自對數分桶直方圖，相對誤差不超過 12.5%。
+ */
+typedef struct {
+    uint32_t count;             /**< 樣本數 */
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t max_us;            /**< 精確最大值 */
+} platform_span_leg_stats_t;
+
+typedef struct {
+    platform_span_leg_stats_t legs[PLATFORM_SPAN_LEG_COUNT];  /**< 以 platform_span_leg_t 為索引 */
+    uint32_t open;              /**< 進行中的 span */
+    uint32_t aborted;           /**< 因錯誤狀態中止 */
+    uint32_t expired;           /**< 逾時未完成或被新的 span 擠出 */
+} platform_span_stats_t;
+
+/**
+ * @brief 獲取延遲統計
+ *
+ * @param out 輸出結果
+ * @param reset 非 0 時讀取後清除統計（進行中的 span 保留）
+ * @return PLATFORM_OK 成功，PLATFORM_ERROR_PARAM 參數為 NULL
+ *
+ * @example
+ *   platform_span_stats_t st;
+ *   platform_get_span_stats(&st, 0);
+ *   printf("p99 %u us\n", st.legs[PLATFORM_SPAN_TOTAL].p99_us);
+ */
+int platform_get_span_stats(platform_span_stats_t *out, int reset);
+
 #ifdef __cplusplus
 }
 #endif
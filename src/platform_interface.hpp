@@ -0,0 +1,740 @@
+/**
+ * @file platform_interface.hpp
+ * @brief Gaming Platform C++20 協程接口
+ *
+ * 建構於 platform_interface.h 之上的純標頭檔 C++20 層：
+ * - platform::session：RAII 管理 platform_init() / platform_cleanup()
+ * - enum class 包裝：led_state、button_state、ps5_power、status
+ * - 可 co_await 的操作：ps5_wake()、power_change()、button_press()、led_fade()
+ *
+ * 所有等待中的操作由 session 擁有的派送執行緒（dispatch thread）統一處理：
+ * button_press() 等待 GPIO 邊緣事件 fd（platform_get_button_fd()），不會漏掉短按；
+ * PS5 電源與動畫依 platform_get_calibration() 的 poll_min_ms / poll_max_ms 自適應輪詢。
+ *
+ * 執行緒:
+ *   HAL 不保證執行緒安全。本標頭的所有 HAL 調用（同步包裝、session、派送執行緒）
+ *   都持有 platform::hal_mutex()；協程本體可能在調用端或派送執行緒上執行，
+ *   直接調用 C 接口時必須自行持有該鎖。
+ *
+ * 結束:
+ *   session 解構時尚未完成的等待以非 ok 結果恢復（在解構 session 的執行緒上），
+ *   之後的 co_await 立即以 status::init 完成。
+ *   重複等待的迴圈必須在結果非 ok 時結束，否則會在 ~session 中無限循環。
+ *
+ * co_await 不會配置記憶體：awaitable 物件本身即為派送佇列的節點，
+ * 存放在協程 frame 中，派送執行緒僅以侵入式鏈結串列串接。
+ *
+ * @example
+ *   using namespace std::chrono_literals;
+ *
+ *   platform::detached on_button() {
+ *       for (;;) {
+ *           platform::status pressed = co_await platform::button_press();
+ *           if (pressed != platform::status::ok) {
+ *               break;  // session 已結束
+ *           }
+ *           platform::status woke = co_await platform::ps5_wake(30s);
+ *           if (woke == platform::status::ok) {
+ *               platform::set_led(platform::led_state::ps5_on);
+ *           }
+ *       }
+ *   }
+ *
+ *   int main() {
+ *       platform::session hal;  // platform_init()，失敗時拋出 platform::error
+ *       on_button();
+ *       ...
+ *   }                           // 停止派送執行緒，on_button() 結束，platform_cleanup()
+ */
+
+#ifndef PLATFORM_INTERFACE_HPP
+#define PLATFORM_INTERFACE_HPP
+
+#include "platform_interface.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace platform {
+
+/* ============================================================================
+ * enum class 包裝
+ * ========================================================================== */
+
+enum class status : int {
+    ok        = PLATFORM_OK,
+    error     = PLATFORM_ERROR,
+    init      = PLATFORM_ERROR_INIT,
+    param     = PLATFORM_ERROR_PARAM,
+    timeout   = PLATFORM_ERROR_TIMEOUT,
+    not_found = PLATFORM_ERROR_NOT_FOUND,
+    busy      = PLATFORM_ERROR_BUSY,
+};
+
+enum class led_state : int {
+    off            = LED_STATE_OFF,
+    ps5_on         = LED_STATE_PS5_ON,
+    ps5_standby    = LED_STATE_PS5_STANDBY,
+    ps5_off        = LED_STATE_PS5_OFF,
+    vpn_connecting = LED_STATE_VPN_CONNECTING,
+    vpn_connected  = LED_STATE_VPN_CONNECTED,
+    vpn_error      = LED_STATE_VPN_ERROR,
+    querying       = LED_STATE_QUERYING,
+    waking         = LED_STATE_WAKING,
+    error          = LED_STATE_ERROR,
+    system_error   = LED_STATE_SYSTEM_ERROR,
+    system_startup = LED_STATE_SYSTEM_STARTUP,
+    vpn_traffic    = LED_STATE_VPN_TRAFFIC,
+};
+
+enum class button_state : int {
+    released    = BUTTON_RELEASED,
+    pressed     = BUTTON_PRESSED,
+    unavailable = BUTTON_UNAVAILABLE,
+};
+
+enum class ps5_power : int {
+    unknown = PLATFORM_PS5_UNKNOWN,
+    off     = PLATFORM_PS5_OFF,
+    standby = PLATFORM_PS5_STANDBY,
+    on      = PLATFORM_PS5_ON,
+};
+
+struct rgb {
+    uint8_t r, g, b;
+
+    friend bool operator==(const rgb&, const rgb&) = default;
+};
+
+/**
+ * @brief platform_init() 失敗或 session 重複建立時拋出
+ */
+class error : public std::runtime_error {
+public:
+    error(status code, const char *what) : std::runtime_error(what), code_(code) {}
+    status code() const noexcept { return code_; }
+
+private:
+    status code_;
+};
+
+/**
+ * @brief 不等待結果的協程型別（fire-and-forget）
+ *
+ * 協程建立後立即執行到第一次 co_await，結束時自行釋放 frame。
+ */
+struct detached {
+    struct promise_type {
+        detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/**
+ * @brief 序列化所有 HAL 調用的鎖
+ */
+inline std::mutex& hal_mutex() noexcept {
+    static std::mutex mutex;
+    return mutex;
+}
+
+/* ============================================================================
+ * 同步操作（持有 hal_mutex() 轉呼 C 接口）
+ * ========================================================================== */
+
+inline status set_led(led_state state) noexcept {
+    std::lock_guard<std::mutex> hal(hal_mutex());
+    return static_cast<status>(
+        platform_set_led_state(static_cast<platform_led_state_t>(state)));
+}
+
+inline status set_led(led_state state, uint32_t span_id) noexcept {
+    std::lock_guard<std::mutex> hal(hal_mutex());
+    return static_cast<status>(platform_set_led_state_span(
+        static_cast<platform_led_state_t>(state), span_id));
+}
+
+inline status set_led(rgb color) noexcept {
+    std::lock_guard<std::mutex> hal(hal_mutex());
+    return static_cast<status>(platform_set_led_rgb(color.r, color.g, color.b));
+}
+
+inline status clear_led_traffic() noexcept {
+    std::lock_guard<std::mutex> hal(hal_mutex());
+    return static_cast<status>(platform_clear_led_traffic());
+}
+
+inline button_state get_button() noexcept {
+    std::lock_guard<std::mutex> hal(hal_mutex());
+    return static_cast<button_state>(platform_get_button_state());
+}
+
+inline ps5_power get_ps5_power() noexcept {
+    std::lock_guard<std::mutex> hal(hal_mutex());
+    return static_cast<ps5_power>(platform_get_ps5_power());
+}
+
+/* ============================================================================
+ * 派送執行緒
+ * ========================================================================== */
+
+namespace detail {
+
+using clock = std::chrono::steady_clock;
+
+/** 單次輪詢取得的硬體狀態，同一輪的所有等待者共用 */
+struct sample {
+    clock::time_point now;
+    button_state button;
+    ps5_power power;
+    bool button_events;             /**< 主按鈕狀態來自邊緣事件（否則為輪詢取樣） */
+    clock::time_point last_press;   /**< 最近一次主按鈕按下的事件時間 */
+};
+
+enum need : unsigned {
+    need_button = 1u << 0,  /**< 需要按鈕狀態 */
+    need_power  = 1u << 1,  /**< 需要 PS5 電源狀態 */
+    need_fast   = 1u << 2,  /**< 固定以最短間隔輪詢（動畫） */
+};
+
+class dispatcher;
+
+/**
+ * @brief 等待節點，同時也是 awaitable 的共同基底
+ *
+ * 節點存在協程 frame 中，由 dispatcher 以 next 指標串接，不另行配置。
+ */
+class waiter {
+public:
+    waiter(const waiter&) = delete;
+    waiter& operator=(const waiter&) = delete;
+
+    bool await_ready() noexcept;
+    bool await_suspend(std::coroutine_handle<> handle) noexcept;
+
+protected:
+    explicit waiter(unsigned needs) noexcept : needs_(needs) {}
+    ~waiter() = default;
+
+    /**
+     * @brief 以本輪狀態推進，在派送執行緒上調用
+     * @return true 表示操作完成，協程將被恢復
+     */
+    virtual bool step(const sample& s) noexcept = 0;
+
+    /** 派送執行緒停止時調用，之後協程隨即恢復 */
+    void cancel() noexcept { result_ = status::error; }
+
+    status result_ = status::ok;
+
+private:
+    friend class dispatcher;
+
+    waiter *next_ = nullptr;
+    std::coroutine_handle<> handle_;
+    dispatcher *dispatcher_ = nullptr;  /**< await_ready() 取得，await_suspend() 不再讀取 g_dispatcher */
+    unsigned needs_;
+};
+
+class dispatcher {
+public:
+    dispatcher() {
+        if (::pipe2(wake_, O_NONBLOCK | O_CLOEXEC) != 0) {
+            throw error(status::error, "platform dispatcher: pipe2 failed");
+        }
+        thread_ = std::thread([this] { run(); });
+    }
+
+    dispatcher(const dispatcher&) = delete;
+    dispatcher& operator=(const dispatcher&) = delete;
+
+    /**
+     * @brief 停止派送執行緒
+     *
+     * 尚未完成的等待以 status::error 結束，並在調用此解構子的執行緒上恢復。
+     * 此時 g_dispatcher 已清空，恢復後的 co_await 立即以 status::init 完成；
+     * 在清空前已取得 dispatcher、停止後才 enqueue 的等待同樣以 status::init 完成。
+     */
+    ~dispatcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake();
+        thread_.join();
+        ::close(wake_[0]);
+        ::close(wake_[1]);
+
+        while (waiter *w = head_) {
+            head_ = w->next_;
+            w->cancel();
+            w->handle_.resume();
+        }
+    }
+
+    /**
+     * @brief 加入等待者
+     *
+     * 在佇列鎖內喚醒：解構子設定 stop_ 之後才會關閉 pipe。
+     *
+     * @return false 表示派送執行緒已停止，等待者未加入
+     */
+    bool enqueue(waiter *w) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            return false;
+        }
+        w->next_ = head_;
+        head_ = w;
+        wake();
+        return true;
+    }
+
+private:
+    void wake() noexcept {
+        // pipe 滿時已有未處理的喚醒
+        [[maybe_unused]] ssize_t n = ::write(wake_[1], "", 1);
+    }
+
+    /**
+     * @brief 讀取按鈕邊緣事件，沒有事件 fd 時退回輪詢取樣
+     * @return 事件 fd，-1 表示使用輪詢
+     */
+    int sample_button(sample& s) noexcept {
+        int fd = platform_get_button_fd();
+        if (fd < 0) {
+            s.button = static_cast<button_state>(platform_get_button_state());
+            return -1;
+        }
+
+        // Linux 上 steady_clock 與 GPIO 事件時間同為 CLOCK_MONOTONIC
+        platform_button_event_t ev;
+        s.button_events = true;
+        while (platform_read_button_event(&ev) == PLATFORM_OK) {
+            if (ev.button != PLATFORM_BUTTON_MAIN) {
+                continue;
+            }
+            s.button = static_cast<button_state>(ev.state);
+            if (ev.state == BUTTON_PRESSED) {
+                s.last_press = clock::time_point(
+                    std::chrono::duration_cast<clock::duration>(
+                        std::chrono::nanoseconds(ev.timestamp_ns)));
+            }
+        }
+        return fd;
+    }
+
+    void run() {
+        platform_calibration_t cal{};
+        {
+            std::lock_guard<std::mutex> hal(hal_mutex());
+            platform_get_calibration(&cal);
+        }
+        const auto poll_min = std::chrono::milliseconds(cal.poll_min_ms ? cal.poll_min_ms : 20);
+        const auto poll_max = std::chrono::milliseconds(
+            std::max(cal.poll_max_ms, cal.poll_min_ms ? cal.poll_min_ms : 20u));
+
+        auto interval = poll_min;
+        sample last{clock::now(), button_state::released, ps5_power::unknown, false, {}};
+        waiter *pending = nullptr;
+        bool holding_buttons = false;
+
+        for (;;) {
+            // 取下新加入的等待者後解鎖，HAL 調用與協程恢復都不持有佇列鎖
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                waiter **tail = &head_;
+                while (*tail) {
+                    tail = &(*tail)->next_;
+                }
+                *tail = pending;
+                pending = std::exchange(head_, nullptr);
+                if (stop_) {
+                    head_ = pending;  // 交給解構子取消
+                    return;
+                }
+            }
+
+            char buf[64];
+            while (::read(wake_[0], buf, sizeof(buf)) > 0) {
+            }
+
+            unsigned needs = 0;
+            for (waiter *w = pending; w; w = w->next_) {
+                needs |= w->needs_;
+            }
+
+            // 按鈕線路是獨佔的，沒有 button_press() 等待時交還給其他行程
+            if (!(needs & need_button) && holding_buttons) {
+                std::lock_guard<std::mutex> hal(hal_mutex());
+                platform_release_buttons();
+                holding_buttons = false;
+            }
+
+            if (!pending) {
+                wait(-1, -1);
+                interval = poll_min;
+                continue;
+            }
+
+            sample s = last;
+            s.now = clock::now();
+            s.button_events = false;
+            int button_fd = -1;
+            {
+                std::lock_guard<std::mutex> hal(hal_mutex());
+                if (needs & need_button) {
+                    button_fd = sample_button(s);
+                    holding_buttons = true;
+                }
+                if (needs & need_power) {
+                    s.power = static_cast<ps5_power>(platform_get_ps5_power());
+                }
+            }
+            bool changed = s.button != last.button || s.power != last.power ||
+                           s.last_press != last.last_press;
+            last = s;
+
+            waiter *ready = nullptr;
+            waiter **link = &pending;
+            while (waiter *w = *link) {
+                if (w->step(s)) {
+                    *link = w->next_;
+                    w->next_ = ready;
+                    ready = w;
+                } else {
+                    link = &w->next_;
+                }
+            }
+
+            // 恢復後協程可能再次 co_await（重新 enqueue），因此先取出 next
+            while (waiter *w = ready) {
+                ready = w->next_;
+                w->handle_.resume();
+                changed = true;
+            }
+
+            // 狀態有變化時維持最短間隔，閒置時逐步退避到上限
+            needs = 0;
+            for (waiter *w = pending; w; w = w->next_) {
+                needs |= w->needs_;
+            }
+            if (changed || (needs & need_fast)) {
+                interval = poll_min;
+            } else {
+                interval = std::min(interval * 2, poll_max);
+            }
+
+            // 只剩等待按鈕事件時不需定時喚醒
+            bool timed = (needs & ~need_button) || ((needs & need_button) && button_fd < 0);
+            wait(timed ? static_cast<int>(interval.count()) : -1,
+                 (needs & need_button) ? button_fd : -1);
+        }
+    }
+
+    /** 等待新的等待者、停止要求或按鈕事件 */
+    void wait(int timeout_ms, int button_fd) noexcept {
+        struct pollfd pfd[2] = {
+            { wake_[0], POLLIN, 0 },
+            { button_fd, POLLIN, 0 },
+        };
+        ::poll(pfd, button_fd >= 0 ? 2 : 1, timeout_ms);
+    }
+
+    std::mutex mutex_;
+    waiter *head_ = nullptr;
+    bool stop_ = false;
+    int wake_[2] = { -1, -1 };
+    std::thread thread_;
+};
+
+inline std::atomic<dispatcher*> g_dispatcher{nullptr};
+inline std::atomic<bool> g_session_active{false};
+
+inline bool waiter::await_ready() noexcept {
+    dispatcher_ = g_dispatcher.load(std::memory_order_acquire);
+    if (!dispatcher_) {
+        result_ = status::init;  // 沒有 session，立即完成
+        return true;
+    }
+    return false;
+}
+
+inline bool waiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+    handle_ = handle;
+    // session 在 await_ready() 之後開始結束：不掛起，與沒有 session 時相同
+    if (!dispatcher_->enqueue(this)) {
+        result_ = status::init;
+        return false;
+    }
+    return true;  // 此後節點屬於派送執行緒，可能已被恢復，不可再存取 this
+}
+
+} // namespace detail
+
+/* ============================================================================
+ * RAII Session
+ * ========================================================================== */
+
+/**
+ * @brief 管理 HAL 生命週期與派送執行緒
+ *
+ * 同一時間只能存在一個 session。
+ */
+class session {
+public:
+    session() { detail::g_dispatcher.store(&dispatcher_, std::memory_order_release); }
+    ~session() { detail::g_dispatcher.store(nullptr, std::memory_order_release); }
+
+    session(const session&) = delete;
+    session& operator=(const session&) = delete;
+
+    const char *version() const noexcept {
+        std::lock_guard<std::mutex> hal(hal_mutex());
+        return platform_get_version();
+    }
+    const char *device_type() const noexcept {
+        std::lock_guard<std::mutex> hal(hal_mutex());
+        return platform_get_device_type();
+    }
+
+private:
+    struct init_guard {
+        init_guard() {
+            if (detail::g_session_active.exchange(true)) {
+                throw error(status::init, "platform session already active");
+            }
+            int rc;
+            {
+                std::lock_guard<std::mutex> hal(hal_mutex());
+                rc = platform_init();
+            }
+            if (rc != PLATFORM_OK) {
+                detail::g_session_active.store(false);
+                throw error(static_cast<status>(rc), "platform_init failed");
+            }
+        }
+        ~init_guard() {
+            std::lock_guard<std::mutex> hal(hal_mutex());
+            platform_cleanup();
+            detail::g_session_active.store(false);
+        }
+    };
+
+    init_guard guard_;               // 先初始化 HAL
+    detail::dispatcher dispatcher_;  // 先於 guard_ 解構
+};
+
+/* ============================================================================
+ * Awaitables
+ * ========================================================================== */
+
+/**
+ * @brief 等待主按鈕按下（RELEASED → PRESSED 邊緣）
+ *
+ * 有邊緣事件 fd 時以核心事件判斷，只計入 awaitable 建立之後的按下，短按不會遺漏；
+ * 否則退回輪詢取樣，等待開始時已按住的按鈕不算，需放開後再次按下。
+ */
+class button_press_awaitable : public detail::waiter {
+public:
+    button_press_awaitable() noexcept : waiter(detail::need_button) {}
+
+    status await_resume() const noexcept { return result_; }
+
+protected:
+    bool step(const detail::sample& s) noexcept override {
+        if (s.button_events) {
+            return s.last_press > start_;
+        }
+        bool edge = armed_ && s.button == button_state::pressed;
+        armed_ = s.button == button_state::released;
+        return edge;
+    }
+
+private:
+    detail::clock::time_point start_ = detail::clock::now();
+    bool armed_ = false;
+};
+
+inline button_press_awaitable button_press() noexcept { return {}; }
+
+/**
+ * @brief 發送喚醒命令並等待 PS5 開機
+ *
+ * 喚醒命令在派送執行緒上發送。
+ * 結果：status::ok 已開機、status::timeout 逾時、其他為喚醒命令的錯誤碼。
+ */
+class ps5_wake_awaitable : public detail::waiter {
+public:
+    explicit ps5_wake_awaitable(std::chrono::milliseconds timeout) noexcept
+        : waiter(detail::need_power), timeout_(timeout) {}
+
+    status await_resume() const noexcept { return result_; }
+
+protected:
+    bool step(const detail::sample& s) noexcept override {
+        if (!sent_) {
+            sent_ = true;
+            deadline_ = s.now + timeout_;
+            int rc;
+            {
+                std::lock_guard<std::mutex> hal(hal_mutex());
+                rc = platform_send_ps5_wake();
+            }
+            if (rc != PLATFORM_OK) {
+                result_ = static_cast<status>(rc);
+                return true;
+            }
+            return false;  // 本輪的電源狀態是發送前的取樣
+        }
+        if (s.power == ps5_power::on) {
+            return true;
+        }
+        if (s.now >= deadline_) {
+            result_ = status::timeout;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::chrono::milliseconds timeout_;
+    detail::clock::time_point deadline_{};
+    bool sent_ = false;
+};
+
+inline ps5_wake_awaitable ps5_wake(std::chrono::milliseconds timeout) noexcept {
+    return ps5_wake_awaitable(timeout);
+}
+
+/**
+ * @brief 等待 PS5 電源狀態改變
+ *
+ * @p from 為 unknown 時以第一次取樣作為基準。
+ * 結果為新的電源狀態；逾時或取消時為 ps5_power::unknown。
+ */
+class power_change_awaitable : public detail::waiter {
+public:
+    power_change_awaitable(std::chrono::milliseconds timeout, ps5_power from) noexcept
+        : waiter(detail::need_power), timeout_(timeout), baseline_(from) {}
+
+    ps5_power await_resume() const noexcept {
+        return result_ == status::ok ? current_ : ps5_power::unknown;
+    }
+
+protected:
+    bool step(const detail::sample& s) noexcept override {
+        if (!started_) {
+            started_ = true;
+            deadline_ = s.now + timeout_;
+            if (baseline_ == ps5_power::unknown) {
+                baseline_ = s.power;
+                return false;
+            }
+        }
+        if (s.power != baseline_ && s.power != ps5_power::unknown) {
+            current_ = s.power;
+            return true;
+        }
+        if (s.now >= deadline_) {
+            result_ = status::timeout;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::chrono::milliseconds timeout_;
+    detail::clock::time_point deadline_{};
+    ps5_power baseline_;
+    ps5_power current_ = ps5_power::unknown;
+    bool started_ = false;
+};
+
+inline power_change_awaitable power_change(std::chrono::milliseconds timeout,
+                                           ps5_power from = ps5_power::unknown) noexcept {
+    return power_change_awaitable(timeout, from);
+}
+
+/**
+ * @brief LED 線性漸變，完成後恢復
+ *
+ * 每輪輪詢更新一次顏色（間隔為 poll_min_ms），顏色未變時不寫入硬體。
+ */
+class led_fade_awaitable : public detail::waiter {
+public:
+    led_fade_awaitable(rgb from, rgb to, std::chrono::milliseconds duration) noexcept
+        : waiter(detail::need_fast), from_(from), to_(to), duration_(duration) {}
+
+    status await_resume() const noexcept { return result_; }
+
+protected:
+    bool step(const detail::sample& s) noexcept override {
+        if (!started_) {
+            started_ = true;
+            start_ = s.now;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(s.now - start_);
+        long num = std::min<long>(static_cast<long>(elapsed.count()),
+                                  static_cast<long>(duration_.count()));
+        long den = std::max<long>(static_cast<long>(duration_.count()), 1);
+        if (duration_.count() <= 0) {
+            num = den;
+        }
+
+        rgb color{lerp(from_.r, to_.r, num, den),
+                  lerp(from_.g, to_.g, num, den),
+                  lerp(from_.b, to_.b, num, den)};
+        if (!written_ || !(color == last_)) {
+            int rc;
+            {
+                std::lock_guard<std::mutex> hal(hal_mutex());
+                rc = platform_set_led_rgb(color.r, color.g, color.b);
+            }
+            if (rc != PLATFORM_OK) {
+                result_ = static_cast<status>(rc);
+                return true;
+            }
+            last_ = color;
+            written_ = true;
+        }
+        return num >= den;
+    }
+
+private:
+    static uint8_t lerp(uint8_t a, uint8_t b, long num, long den) noexcept {
+        return static_cast<uint8_t>(a + (static_cast<long>(b) - a) * num / den);
+    }
+
+    rgb from_;
+    rgb to_;
+    std::chrono::milliseconds duration_;
+    detail::clock::time_point start_{};
+    rgb last_{};
+    bool started_ = false;
+    bool written_ = false;
+};
+
+inline led_fade_awaitable led_fade(rgb from, rgb to, std::chrono::milliseconds duration) noexcept {
+    return led_fade_awaitable(from, to, duration);
+}
+
+} // namespace platform
+
+#endif /* PLATFORM_INTERFACE_HPP */
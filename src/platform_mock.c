@@ -14,6 +14,7 @@
  * @date 2024-11-17
  */
 
+#define PLATFORM_IMPLEMENTATION
 #include "platform_interface.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -38,6 +39,12 @@ static struct {
     // LED 狀態
     platform_led_state_t led_state;
     uint8_t led_rgb[3];  // R, G, B
+    bool led_custom;     // 由 platform_set_led_rgb() 設定
+    struct {
+        platform_led_state_t state;
+        uint8_t rgb[3];
+        bool custom;
+    } led_saved;         // 進入 VPN_TRAFFIC 前的狀態
     
     // Button 狀態
     platform_button_state_t button_state;
@@ -149,6 +156,9 @@ static void led_state_to_rgb(platform_led_state_t state, uint8_t *r, uint8_t *g,
         case LED_STATE_ERROR:
             *r = 255; *g = 0; *b = 0;  // 紅色閃爍
             break;
+        case LED_STATE_VPN_TRAFFIC:
+            *r = 0; *g = 255; *b = 0;  // 綠色，隨流量閃爍
+            break;
         default:
             *r = 0; *g = 0; *b = 0;
             break;
@@ -250,12 +260,19 @@ platform_result_t platform_set_led_state(platform_led_state_t state) {
         return PLATFORM_ERROR_NOT_INITIALIZED;
     }
     
-    if (state < LED_STATE_OFF || state > LED_STATE_ERROR) {
+    if (state < LED_STATE_OFF ||
+        (state > LED_STATE_ERROR && state != LED_STATE_VPN_TRAFFIC)) {
         set_error("Invalid LED state: %d", state);
         return PLATFORM_ERROR_INVALID_PARAM;
     }
     
+    if (state == LED_STATE_VPN_TRAFFIC && g_mock_platform.led_state != LED_STATE_VPN_TRAFFIC) {
+        g_mock_platform.led_saved.state = g_mock_platform.led_state;
+        memcpy(g_mock_platform.led_saved.rgb, g_mock_platform.led_rgb, 3);
+        g_mock_platform.led_saved.custom = g_mock_platform.led_custom;
+    }
     g_mock_platform.led_state = state;
+    g_mock_platform.led_custom = false;
     g_mock_platform.stats.led_set_count++;
     
     // 轉換為 RGB
@@ -271,6 +288,15 @@ platform_result_t platform_set_led_state(platform_led_state_t state) {
     return PLATFORM_OK;
 }
 
+/**
+ * @brief 設定 LED 狀態並回報到延遲 span
+ * @return 同 platform_set_led_state()（模擬環境不記錄 span）
+ */
+int platform_set_led_state_span(platform_led_state_t state, uint32_t span_id) {
+    (void)span_id;
+    return platform_set_led_state(state);
+}
+
 /**
  * @brief 設定 LED RGB 顏色 (可選)
  * @param r 紅色 (0-255)
@@ -287,6 +313,7 @@ platform_result_t platform_set_led_rgb(uint8_t r, uint8_t g, uint8_t b) {
     g_mock_platform.led_rgb[0] = r;
     g_mock_platform.led_rgb[1] = g;
     g_mock_platform.led_rgb[2] = b;
+    g_mock_platform.led_custom = true;
     g_mock_platform.stats.led_set_count++;
     
     printf("[Platform Mock] LED RGB set to (%d, %d, %d)\n", r, g, b);
@@ -294,6 +321,38 @@ platform_result_t platform_set_led_rgb(uint8_t r, uint8_t g, uint8_t b) {
     return PLATFORM_OK;
 }
 
+/**
+ * @brief 結束 VPN 流量指示，恢復進入前的狀態
+ * @return PLATFORM_OK（模擬環境沒有 netdev trigger）
+ */
+int platform_clear_led_traffic(void) {
+    if (g_mock_platform.led_state != LED_STATE_VPN_TRAFFIC) {
+        return PLATFORM_OK;
+    }
+    g_mock_platform.led_state = g_mock_platform.led_saved.state;
+    memcpy(g_mock_platform.led_rgb, g_mock_platform.led_saved.rgb, 3);
+    g_mock_platform.led_custom = g_mock_platform.led_saved.custom;
+    printf("[Platform Mock] LED traffic indication cleared\n");
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 取得目前 LED 狀態
+ * @param info 輸出
+ * @return PLATFORM_OK 成功, PLATFORM_ERROR_PARAM 參數錯誤
+ */
+int platform_get_led(platform_led_info_t *info) {
+    if (!info) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    info->state = g_mock_platform.led_state;
+    info->custom = g_mock_platform.led_custom;
+    info->r = g_mock_platform.led_rgb[0];
+    info->g = g_mock_platform.led_rgb[1];
+    info->b = g_mock_platform.led_rgb[2];
+    return PLATFORM_OK;
+}
+
 /**
  * @brief 取得按鈕狀態
  * @return 按鈕狀態
@@ -315,6 +374,47 @@ platform_button_state_t platform_get_button_state(void) {
     return state;
 }
 
+/**
+ * @brief 同時讀取所有按鈕 (Mock: 只有主按鈕)
+ * @param mask 位元遮罩輸出
+ * @return PLATFORM_OK 成功, PLATFORM_ERROR_PARAM 參數錯誤
+ */
+int platform_get_buttons(uint32_t *mask) {
+    if (!mask) {
+        return PLATFORM_ERROR_PARAM;
+    }
+
+    *mask = (platform_get_button_state() == PLATFORM_BUTTON_PRESSED)
+        ? (1u << PLATFORM_BUTTON_MAIN) : 0;
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 取得按鈕事件 fd (Mock: 不支援事件)
+ * @return -1
+ */
+int platform_get_button_fd(void) {
+    return -1;
+}
+
+/**
+ * @brief 釋放按鈕線路 (Mock: 沒有線路可釋放)
+ */
+void platform_release_buttons(void) {
+}
+
+/**
+ * @brief 讀取按鈕事件 (Mock: 永遠沒有事件)
+ * @param event 事件輸出
+ * @return PLATFORM_ERROR_NOT_FOUND
+ */
+int platform_read_button_event(platform_button_event_t *event) {
+    if (!event) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    return PLATFORM_ERROR_NOT_FOUND;
+}
+
 /**
  * @brief 取得 PS5 電源狀態
  * @return PS5 電源狀態
@@ -365,6 +465,15 @@ platform_result_t platform_send_ps5_wake(void) {
     return PLATFORM_OK;
 }
 
+/**
+ * @brief 發送 PS5 喚醒命令並回報到延遲 span
+ * @return 同 platform_send_ps5_wake()（模擬環境不記錄 span）
+ */
+int platform_send_ps5_wake_span(uint32_t span_id) {
+    (void)span_id;
+    return platform_send_ps5_wake();
+}
+
 /**
  * @brief 取得最後錯誤訊息
  * @return 錯誤訊息字串, 無錯誤返回 NULL
@@ -395,7 +504,55 @@ platform_result_t platform_reset(void) {
     memset(g_mock_platform.last_error, 0, sizeof(g_mock_platform.last_error));
     
     printf("[Platform Mock] Reset complete\n");
-    
+
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 執行硬體校準 (Mock: 使用固定的模擬量測值)
+ * @return PLATFORM_OK
+ */
+int platform_calibrate(void) {
+    printf("[Platform Mock] Calibration skipped, using simulated latencies\n");
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 取得校準結果
+ * @param out 輸出結果
+ * @return PLATFORM_OK 成功, PLATFORM_ERROR_PARAM 參數錯誤
+ */
+int platform_get_calibration(platform_calibration_t *out) {
+    if (!out) {
+        return PLATFORM_ERROR_PARAM;
+    }
+
+    // 模擬典型 OpenWrt One 量測值
+    out->sysfs_write_us = 40;
+    out->gpio_read_us = 15;
+    out->cec_rtt_us = 30000;
+    out->ps5_response_us = 120000;
+    out->cache_ttl_ms = 500;
+    out->poll_min_ms = 5;
+    out->poll_max_ms = 50;
+    out->cec_timeout_ms = 200;
+    out->ps5_reply_timeout_ms = 360;
+
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 獲取延遲統計
+ * @param out 輸出結果（模擬環境沒有按鈕事件，全部為 0）
+ * @param reset 未使用
+ * @return PLATFORM_OK 成功, PLATFORM_ERROR_PARAM 參數錯誤
+ */
+int platform_get_span_stats(platform_span_stats_t *out, int reset) {
+    (void)reset;
+    if (!out) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    memset(out, 0, sizeof(*out));
     return PLATFORM_OK;
 }
 
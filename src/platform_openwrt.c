@@ -1,35 +1,1776 @@
-
 /**
  * @file platform_openwrt.c
- * @brief OpenWrt One implementation (hardware team fills this)
+ * @brief OpenWrt One implementation
  */
 
+#define PLATFORM_IMPLEMENTATION
 #include "platform_interface.h"
+#include "platform_config.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <linux/gpio.h>
+#include <linux/cec.h>
+
+/* 硬體路徑與可調參數來自 config blob，見 platform_config.h */
+
+/* 套件建置時由 Makefile 以 PKG_VERSION 定義 */
+#ifndef PLATFORM_VERSION
+#define PLATFORM_VERSION "1.0.0"
+#endif
+
+#ifndef PLATFORM_CALIBRATION_PATH
+#define PLATFORM_CALIBRATION_PATH "/etc/gaming-platform/calibration"
+#endif
+
+#ifndef PLATFORM_CEC_TOPOLOGY_PATH
+#define PLATFORM_CEC_TOPOLOGY_PATH "/etc/gaming-platform/cec-topology"
+#endif
+
+/* 未量測時使用的預設策略 */
+#define DEFAULT_CACHE_TTL_MS            1000
+#define DEFAULT_POLL_MIN_MS             20
+#define DEFAULT_POLL_MAX_MS             100
+#define DEFAULT_CEC_TIMEOUT_MS          1000
+#define DEFAULT_PS5_REPLY_TIMEOUT_MS    1000
+
+#define CALIB_SAMPLES       8   // 本地量測（sysfs / GPIO）取樣次數
+#define CALIB_CEC_SAMPLES   4   // CEC 量測取樣次數（每次佔用匯流排數十毫秒）
+#define CALIB_FILE_VERSION  1
+
+#define MMIO_SELF_CHECK_SAMPLES 8  // 暫存器與 chardev 必須連續一致的次數
+
+#define BUTTON_DEBOUNCE_US  10000   // 核心邊緣事件去彈跳
+
+#define CEC_TOPOLOGY_VERSION     1
+#define CEC_VENDOR_SONY          0x080046
+#define CEC_NUM_LOG_ADDRS        15       // 0-14，15 為廣播
+
+#define CONFIG_CHECK_INTERVAL_US    1000000  // 檢查 blob 是否更新的最短間隔
+
+/* ============================================================================
+ * 內部狀態
+ * ========================================================================== */
+
+static struct {
+    bool initialized;
+    platform_calibration_t calib;
+    char last_error[256];
+
+    // 按鈕：所有按鈕線路共用一個 line request
+    int button_fd;              // -1 表示尚未開啟
+    uint32_t button_count;
+    uint32_t button_lines[PLATFORM_CONFIG_MAX_BUTTONS];
+    bool button_events;         // 是否已啟用邊緣事件
+
+    // LED
+    platform_led_state_t led_state;
+    uint8_t led_rgb[PLATFORM_CONFIG_LED_CHANNELS];
+    int led_fd[PLATFORM_CONFIG_LED_CHANNELS];       // brightness，-1 表示尚未開啟
+    uint32_t led_max[PLATFORM_CONFIG_LED_CHANNELS]; // max_brightness
+    bool led_blinking;          // sysfs trigger（timer / netdev）使用中
+    bool led_traffic;           // LED_STATE_VPN_TRAFFIC（netdev trigger）使用中
+    bool led_custom;            // 目前顏色由 platform_set_led_rgb() 設定
+    struct {
+        platform_led_state_t state;
+        uint8_t rgb[PLATFORM_CONFIG_LED_CHANNELS];
+        bool blinking;
+        bool custom;
+    } led_saved;                // 進入流量指示前的 LED 狀態
+
+    // GPIO 暫存器直接存取（NULL 表示停用）
+    volatile uint32_t *mmio;
+    size_t mmio_size;
+    struct {
+        uint32_t din_reg;
+        uint32_t dout_reg;
+        uint32_t set_reg;
+        uint32_t clr_reg;
+        uint32_t button_count;
+        uint32_t button_bits[PLATFORM_CONFIG_MAX_BUTTONS];
+        uint32_t button_active_low;
+        uint32_t led_bits[PLATFORM_CONFIG_LED_CHANNELS];
+        uint32_t led_active_low;
+    } mmio_cfg;                 // 開啟時的配置快照，快速路徑不必查詢配置
+
+    // PS5（HDMI-CEC）
+    int cec_fd;                 // -1 表示尚未開啟
+    uint8_t cec_self;           // 我方邏輯位址
+    uint8_t ps5_la;             // PS5 邏輯位址，CEC_LOG_ADDR_INVALID 表示未知
+    uint16_t ps5_phys;          // PS5 實體位址
+    struct {
+        bool present;
+        uint16_t phys;
+        uint32_t vendor;
+    } cec_devices[CEC_NUM_LOG_ADDRS];   // 匯流排拓撲（邏輯位址 → 實體位址 / 廠商）
+    platform_ps5_power_t ps5_power;     // 電源狀態快取
+    uint64_t ps5_power_us;              // 快取時間，0 表示無效
+} g_platform = {
+    .button_fd = -1,
+    .led_fd = { -1, -1, -1 },
+    .cec_fd = -1,
+    .ps5_la = CEC_LOG_ADDR_INVALID,
+    .ps5_phys = CEC_PHYS_ADDR_INVALID,
+};
+
+static void set_error(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(g_platform.last_error, sizeof(g_platform.last_error), format, args);
+    va_end(args);
+}
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static uint32_t clamp_u32(uint32_t v, uint32_t lo, uint32_t hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/* ============================================================================
+ * 配置（config blob）
+ * ========================================================================== */
+
+/**
+ * @brief 配置狀態
+ *
+ * current 指向目前使用的配置：映射中的 blob，或沒有 blob 時的內建預設值。
+ * blob 更新時以原子操作切換指標；舊映射保留一個世代才解除，
+ * 讓切換瞬間仍持有舊指標的調用者不會讀到已解除的記憶體。
+ */
+static struct {
+    const platform_config_t *current;
+    void *map;              // 目前映射
+    void *retired;          // 上一世代映射，下次切換時解除
+    dev_t dev;
+    ino_t ino;
+    struct timespec mtime;
+    uint64_t checked_us;
+    platform_config_t defaults;
+} g_config;
+
+/**
+ * @brief 檢查會被當作索引或路徑使用的欄位
+ *
+ * CRC 只能證明內容完整，不能證明內容合理：按鈕數與 PS5 CEC 位址直接作為陣列索引，
+ * 路徑與介面名稱直接交給 open()，必須在 blob 內以 NUL 結尾。
+ *
+ * @return true 全部有效，false 時以 set_error() 說明第一個無效欄位
+ */
+static bool config_fields_valid(const platform_config_t *cfg) {
+    const struct {
+        const char *name;
+        const char *value;
+        size_t size;
+    } strings[] = {
+        { "led_red",        cfg->led_red,        sizeof(cfg->led_red) },
+        { "led_green",      cfg->led_green,      sizeof(cfg->led_green) },
+        { "led_blue",       cfg->led_blue,       sizeof(cfg->led_blue) },
+        { "vpn_interface",  cfg->vpn_interface,  sizeof(cfg->vpn_interface) },
+        { "gpio_chip",      cfg->gpio_chip,      sizeof(cfg->gpio_chip) },
+        { "gpio_mmio_path", cfg->gpio_mmio_path, sizeof(cfg->gpio_mmio_path) },
+        { "cec_device",     cfg->cec_device,     sizeof(cfg->cec_device) },
+    };
+
+    if (cfg->button_count > PLATFORM_CONFIG_MAX_BUTTONS) {
+        set_error("Config blob invalid: button_count %u exceeds %d",
+                  cfg->button_count, PLATFORM_CONFIG_MAX_BUTTONS);
+        return false;
+    }
+    if (cfg->ps5_cec_addr >= CEC_NUM_LOG_ADDRS) {
+        set_error("Config blob invalid: ps5_cec_addr %u out of range", cfg->ps5_cec_addr);
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        if (!memchr(strings[i].value, '\0', strings[i].size)) {
+            set_error("Config blob invalid: %s not terminated", strings[i].name);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 驗證並映射 blob
+ *
+ * 檢查通過後整個 blob 即可直接當作 platform_config_t 使用。
+ */
+static const platform_config_t *config_map(int fd, const struct stat *st) {
+    if (st->st_size != (off_t)sizeof(platform_config_t)) {
+        set_error("Config blob size %lld, expected %zu",
+                  (long long)st->st_size, sizeof(platform_config_t));
+        return NULL;
+    }
+
+    void *map = mmap(NULL, sizeof(platform_config_t), PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        set_error("Cannot map config blob: %s", strerror(errno));
+        return NULL;
+    }
+
+    const platform_config_t *cfg = map;
+    if (cfg->header.magic != PLATFORM_CONFIG_MAGIC ||
+        cfg->header.version != PLATFORM_CONFIG_VERSION ||
+        cfg->header.header_size != sizeof(cfg->header) ||
+        cfg->header.size != sizeof(*cfg) ||
+        cfg->header.crc32 != platform_config_checksum(cfg)) {
+        set_error("Config blob invalid (version %u, expected %u)",
+                  cfg->header.version, PLATFORM_CONFIG_VERSION);
+        munmap(map, sizeof(platform_config_t));
+        return NULL;
+    }
+    if (!config_fields_valid(cfg)) {
+        munmap(map, sizeof(platform_config_t));
+        return NULL;
+    }
+    return cfg;
+}
+
+static void derive_policies(platform_calibration_t *c);
+
+/**
+ * @brief blob 檔案變更時重新映射並切換
+ *
+ * 工具以 rename 取代檔案，因此 inode 或 mtime 改變即代表新世代。
+ * 新 blob 無效時繼續使用目前配置。
+ *
+ * 切換後立即生效：LED 路徑、vpn_interface、button_active_low、ps5_cec_addr
+ * 以及策略覆寫（以保存的量測值重新推導 g_platform.calib）。
+ * 已開啟的裝置（gpio_chip、button_lines、gpio_mmio_*、cec_device）
+ * 需 platform_reset() 才會依新配置重新開啟。
+ */
+static void config_refresh(void) {
+    struct stat st;
+
+    if (stat(PLATFORM_CONFIG_BLOB_PATH, &st) != 0) {
+        return;  // 沒有 blob：維持目前配置（預設值或最後一份有效 blob）
+    }
+    if (g_config.map &&
+        st.st_dev == g_config.dev && st.st_ino == g_config.ino &&
+        st.st_mtim.tv_sec == g_config.mtime.tv_sec &&
+        st.st_mtim.tv_nsec == g_config.mtime.tv_nsec) {
+        return;
+    }
+
+    int fd = open(PLATFORM_CONFIG_BLOB_PATH, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    const platform_config_t *cfg = config_map(fd, &st);
+    close(fd);
+
+    g_config.dev = st.st_dev;
+    g_config.ino = st.st_ino;
+    g_config.mtime = st.st_mtim;
+    if (!cfg) {
+        return;
+    }
+
+    if (g_config.retired) {
+        munmap(g_config.retired, sizeof(platform_config_t));
+    }
+    g_config.retired = g_config.map;
+    g_config.map = (void *)cfg;
+    __atomic_store_n(&g_config.current, cfg, __ATOMIC_RELEASE);
+
+    if (g_platform.initialized) {
+        derive_policies(&g_platform.calib);
+    }
+
+    printf("[Platform OpenWrt] Config generation %u loaded\n", cfg->header.generation);
+}
+
+/**
+ * @brief 取得目前配置
+ *
+ * 每秒最多檢查一次 blob 是否更新，其餘情況只是讀取一個指標。
+ */
+static const platform_config_t *config(void) {
+    uint64_t now = now_us();
+
+    if (!g_config.current) {
+        platform_config_defaults(&g_config.defaults);
+        g_config.current = &g_config.defaults;
+        g_config.checked_us = now - CONFIG_CHECK_INTERVAL_US;
+    }
+    if (now - g_config.checked_us >= CONFIG_CHECK_INTERVAL_US) {
+        g_config.checked_us = now;
+        config_refresh();
+    }
+    return __atomic_load_n(&g_config.current, __ATOMIC_ACQUIRE);
+}
+
+static void config_release(void) {
+    if (g_config.retired) {
+        munmap(g_config.retired, sizeof(platform_config_t));
+    }
+    if (g_config.map) {
+        munmap(g_config.map, sizeof(platform_config_t));
+    }
+    memset(&g_config, 0, sizeof(g_config));
+}
+
+/* ============================================================================
+ * 按鈕（GPIO chardev v2）
+ * ========================================================================== */
+
+#if PLATFORM_FEATURE_BUTTON
+/**
+ * @brief 以單一 line request 取得所有按鈕線路
+ *
+ * 線路在 request 中的索引即按鈕編號，因此 GET_VALUES 的位元遮罩
+ * 可直接作為 platform_get_buttons() 的結果。
+ * 邊緣偵測預設關閉，只輪詢的應用不會在核心累積無人讀取的事件。
+ */
+static int button_open(void) {
+    struct gpio_v2_line_request req;
+    const platform_config_t *cfg = config();
+
+    if (g_platform.button_fd >= 0) {
+        return PLATFORM_OK;
+    }
+    if (cfg->button_count == 0) {
+        set_error("No button lines configured");
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    int chip = open(cfg->gpio_chip, O_RDONLY | O_CLOEXEC);
+    if (chip < 0) {
+        set_error("Cannot open %s: %s", cfg->gpio_chip, strerror(errno));
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    memset(&req, 0, sizeof(req));
+    for (uint32_t i = 0; i < cfg->button_count; i++) {
+        req.offsets[i] = cfg->button_lines[i];
+    }
+    req.num_lines = cfg->button_count;
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+    if (cfg->button_active_low) {
+        req.config.flags |= GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    }
+    strncpy(req.consumer, "gaming-platform", sizeof(req.consumer) - 1);
+
+    int ret = ioctl(chip, GPIO_V2_GET_LINE_IOCTL, &req);
+    int err = errno;
+    close(chip);
+    if (ret < 0 && err == EBUSY) {
+        set_error("Button lines are held by another process");
+        return PLATFORM_ERROR_BUSY;
+    }
+    if (ret < 0) {
+        set_error("Cannot request button lines: %s", strerror(err));
+        return PLATFORM_ERROR;
+    }
+
+    fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+
+    g_platform.button_fd = req.fd;
+    g_platform.button_count = cfg->button_count;
+    memcpy(g_platform.button_lines, cfg->button_lines, sizeof(g_platform.button_lines));
+    g_platform.button_events = false;
+    return PLATFORM_OK;
+}
+
+static void button_close(void) {
+    if (g_platform.button_fd >= 0) {
+        close(g_platform.button_fd);
+        g_platform.button_fd = -1;
+    }
+    g_platform.button_events = false;
+}
+
+/**
+ * @brief 在既有的 line request 上啟用雙邊緣偵測
+ */
+static int button_enable_events(void) {
+    struct gpio_v2_line_config lc;
+
+    if (g_platform.button_events) {
+        return PLATFORM_OK;
+    }
+
+    memset(&lc, 0, sizeof(lc));
+    lc.flags = GPIO_V2_LINE_FLAG_INPUT |
+               GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    if (config()->button_active_low) {
+        lc.flags |= GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    }
+
+    // 接點彈跳不產生多餘事件；控制器不支援時 gpiolib 以軟體去彈跳
+    lc.num_attrs = 1;
+    lc.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+    lc.attrs[0].attr.debounce_period_us = BUTTON_DEBOUNCE_US;
+    lc.attrs[0].mask = (1ULL << g_platform.button_count) - 1;
+
+    if (ioctl(g_platform.button_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &lc) < 0) {
+        // 較舊的核心不接受 debounce 屬性，span 仍由 SPAN_REOPEN_US 過濾彈跳
+        lc.num_attrs = 0;
+        if (ioctl(g_platform.button_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &lc) < 0) {
+            set_error("Cannot enable button events: %s", strerror(errno));
+            return PLATFORM_ERROR;
+        }
+    }
+
+    g_platform.button_events = true;
+    return PLATFORM_OK;
+}
+#endif /* PLATFORM_FEATURE_BUTTON */
+
+/* ============================================================================
+ * GPIO 暫存器直接存取（低延遲模式）
+ * ========================================================================== */
+
+/**
+ * @brief 以單次 volatile 讀取取得所有按鈕
+ */
+static inline uint32_t mmio_get_buttons(void) {
+    uint32_t din = g_platform.mmio[g_platform.mmio_cfg.din_reg / 4];
+    uint32_t mask = 0;
+
+    if (g_platform.mmio_cfg.button_active_low) {
+        din = ~din;
+    }
+    for (uint32_t i = 0; i < g_platform.mmio_cfg.button_count; i++) {
+        mask |= ((din >> g_platform.mmio_cfg.button_bits[i]) & 1u) << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief 以暫存器寫入設定 LED（只有亮/滅，亮度 >= 128 視為亮）
+ *
+ * 有 SET/CLR 暫存器時直接寫入，不影響同一暫存器上的其他腳位；
+ * 否則對 DOUT 做一次讀-改-寫。
+ */
+static void mmio_set_led(uint8_t r, uint8_t g, uint8_t b) {
+    const uint8_t rgb[PLATFORM_CONFIG_LED_CHANNELS] = { r, g, b };
+    uint32_t high = 0;
+    uint32_t all = 0;
+
+    for (int i = 0; i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+        uint32_t bit = 1u << g_platform.mmio_cfg.led_bits[i];
+        bool on = rgb[i] >= 128;
+        all |= bit;
+        if (on != (bool)g_platform.mmio_cfg.led_active_low) {
+            high |= bit;
+        }
+    }
+
+    volatile uint32_t *regs = g_platform.mmio;
+    if (g_platform.mmio_cfg.set_reg != PLATFORM_CONFIG_NO_REG) {
+        regs[g_platform.mmio_cfg.set_reg / 4] = high;
+        regs[g_platform.mmio_cfg.clr_reg / 4] = all & ~high;
+    } else {
+        uint32_t dout = regs[g_platform.mmio_cfg.dout_reg / 4];
+        regs[g_platform.mmio_cfg.dout_reg / 4] = (dout & ~all) | high;
+    }
+}
+
+static void mmio_close(void) {
+    if (g_platform.mmio) {
+        munmap((void *)g_platform.mmio, g_platform.mmio_size);
+        g_platform.mmio = NULL;
+    }
+}
+
+static bool mmio_reg_valid(uint32_t reg) {
+    return reg % 4 == 0 && reg <= g_platform.mmio_size - 4;
+}
+
+/**
+ * @brief 啟動自我檢查，任一項失敗即停用暫存器存取
+ *
+ * - 暫存器偏移須 4 位元組對齊且落在映射範圍內，位元編號小於 32
+ * - DOUT 寫回原值後讀回必須一致（確認映射可寫且是真實暫存器）
+ * - 在目標硬體上，連續數次以暫存器與 GPIO chardev 同時讀取按鈕，結果必須完全一致
+ *   （確認 DIN 偏移、位元與極性設定正確）
+ *
+ * 映射對象是一般檔案（測試用暫存器映像）時略過與 chardev 的比對。
+ */
+static int mmio_self_check(bool image) {
+    volatile uint32_t *regs = g_platform.mmio;
+    bool valid = g_platform.mmio_size >= 4 &&
+                 mmio_reg_valid(g_platform.mmio_cfg.din_reg) &&
+                 mmio_reg_valid(g_platform.mmio_cfg.dout_reg);
+
+    if (valid && g_platform.mmio_cfg.set_reg != PLATFORM_CONFIG_NO_REG) {
+        valid = mmio_reg_valid(g_platform.mmio_cfg.set_reg) &&
+                mmio_reg_valid(g_platform.mmio_cfg.clr_reg);
+    }
+    for (uint32_t i = 0; valid && i < g_platform.mmio_cfg.button_count; i++) {
+        valid = g_platform.mmio_cfg.button_bits[i] < 32;
+    }
+    for (int i = 0; valid && i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+        valid = g_platform.mmio_cfg.led_bits[i] < 32;
+    }
+    if (!valid) {
+        set_error("GPIO mmio self-check: register offset or bit out of range");
+        return PLATFORM_ERROR;
+    }
+
+    uint32_t dout = regs[g_platform.mmio_cfg.dout_reg / 4];
+
+    regs[g_platform.mmio_cfg.dout_reg / 4] = dout;
+    if (regs[g_platform.mmio_cfg.dout_reg / 4] != dout) {
+        set_error("GPIO mmio self-check: DOUT readback mismatch");
+        return PLATFORM_ERROR;
+    }
 
-// TODO: 硬體團隊實作所有接口
-// 內部實作方式完全自由：
-// - 可使用 ADC
-// - 可使用 HW ID
-// - 可使用 GPIO
-// - 可使用任何其他方式
+#if PLATFORM_FEATURE_BUTTON
+    if (!image) {
+        struct gpio_v2_line_values values;
+        bool held = g_platform.button_fd >= 0;
+        int ret = PLATFORM_OK;
+
+        if (button_open() != PLATFORM_OK) {
+            return PLATFORM_ERROR;
+        }
+        for (int i = 0; i < MMIO_SELF_CHECK_SAMPLES && ret == PLATFORM_OK; i++) {
+            values.bits = 0;
+            values.mask = (1ULL << g_platform.button_count) - 1;
+            if (ioctl(g_platform.button_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+                set_error("GPIO mmio self-check: chardev read failed: %s", strerror(errno));
+                ret = PLATFORM_ERROR;
+                break;
+            }
+            uint32_t mask = mmio_get_buttons();
+            if (mask != (uint32_t)values.bits) {
+                set_error("GPIO mmio self-check: buttons 0x%x via registers, 0x%x via chardev",
+                          mask, (uint32_t)values.bits);
+                ret = PLATFORM_ERROR;
+            }
+        }
+
+        // 比對完立即交還線路：mmio 模式以暫存器讀取，不應佔用獨佔的 line request
+        // （檢查前已持有，例如已啟用邊緣事件時保留）
+        if (!held) {
+            button_close();
+        }
+        if (ret != PLATFORM_OK) {
+            return ret;
+        }
+    }
+#else
+    (void)image;
+#endif
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 映射 GPIO 暫存器（/dev/uioN、/dev/mem 或暫存器映像檔）
+ */
+static int mmio_open(void) {
+    const platform_config_t *cfg = config();
+    struct stat st;
+
+    if (g_platform.mmio || cfg->gpio_mmio_path[0] == '\0') {
+        return PLATFORM_OK;
+    }
+
+    int fd = open(cfg->gpio_mmio_path, O_RDWR | O_SYNC | O_CLOEXEC);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        set_error("Cannot open %s: %s", cfg->gpio_mmio_path, strerror(errno));
+        if (fd >= 0) close(fd);
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    bool image = S_ISREG(st.st_mode);
+    if (image && st.st_size < (off_t)cfg->gpio_mmio_offset + (off_t)cfg->gpio_mmio_size) {
+        set_error("Register image %s too small", cfg->gpio_mmio_path);
+        close(fd);
+        return PLATFORM_ERROR;
+    }
+
+    void *map = mmap(NULL, cfg->gpio_mmio_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd, (off_t)cfg->gpio_mmio_offset);
+    close(fd);
+    if (map == MAP_FAILED) {
+        set_error("Cannot map %s: %s", cfg->gpio_mmio_path, strerror(errno));
+        return PLATFORM_ERROR;
+    }
+
+    g_platform.mmio = map;
+    g_platform.mmio_size = cfg->gpio_mmio_size;
+    g_platform.mmio_cfg.din_reg = cfg->mmio_din_reg;
+    g_platform.mmio_cfg.dout_reg = cfg->mmio_dout_reg;
+    g_platform.mmio_cfg.set_reg = cfg->mmio_dout_set_reg;
+    g_platform.mmio_cfg.clr_reg = cfg->mmio_dout_clr_reg;
+    g_platform.mmio_cfg.button_count = cfg->button_count;
+    memcpy(g_platform.mmio_cfg.button_bits, cfg->mmio_button_bits,
+           sizeof(g_platform.mmio_cfg.button_bits));
+    g_platform.mmio_cfg.button_active_low = cfg->button_active_low;
+    memcpy(g_platform.mmio_cfg.led_bits, cfg->mmio_led_bits,
+           sizeof(g_platform.mmio_cfg.led_bits));
+    g_platform.mmio_cfg.led_active_low = cfg->mmio_led_active_low;
+
+    if (mmio_self_check(image) != PLATFORM_OK) {
+        fprintf(stderr, "[Platform OpenWrt] %s, falling back to chardev/sysfs\n",
+                g_platform.last_error);
+        mmio_close();
+        return PLATFORM_ERROR;
+    }
+
+    printf("[Platform OpenWrt] GPIO registers mapped from %s%s\n",
+           cfg->gpio_mmio_path, image ? " (register image)" : "");
+    return PLATFORM_OK;
+}
+
+/* ============================================================================
+ * LED（sysfs LED class）
+ * ========================================================================== */
+
+/**
+ * @brief 各 LED 狀態的顏色與閃爍週期
+ */
+static const struct {
+    uint8_t r, g, b;
+    uint16_t blink_ms;      // 0 表示恆亮
+    bool netdev;            // 依 VPN 介面流量閃爍（顏色見 led_apply_traffic）
+} k_led_patterns[] = {
+    [LED_STATE_OFF]            = {   0,   0,   0,   0 },
+    [LED_STATE_PS5_ON]         = { 255, 255, 255,   0 },  // 白色
+    [LED_STATE_PS5_STANDBY]    = { 255, 128,   0,   0 },  // 橙色
+    [LED_STATE_PS5_OFF]        = {   0,   0,   0,   0 },
+    [LED_STATE_VPN_CONNECTING] = {   0,   0, 255, 500 },  // 藍色閃爍
+    [LED_STATE_VPN_CONNECTED]  = {   0, 255,   0,   0 },  // 綠色
+    [LED_STATE_VPN_ERROR]      = { 255,   0,   0, 500 },  // 紅色閃爍
+    [LED_STATE_QUERYING]       = { 128,   0, 255, 500 },  // 紫色閃爍
+    [LED_STATE_WAKING]         = { 255, 255,   0, 500 },  // 黃色閃爍
+    [LED_STATE_ERROR]          = { 255,   0,   0,   0 },  // 紅色
+    [LED_STATE_SYSTEM_ERROR]   = { 255,   0,   0, 100 },  // 紅色快閃
+    [LED_STATE_SYSTEM_STARTUP] = { 255, 255,   0,   0 },  // 黃色
+    [LED_STATE_VPN_TRAFFIC]    = {   0, 255,   0,   0, true },  // 預設綠色，隨流量閃爍
+};
+
+static const char *led_dir(const platform_config_t *cfg, int channel) {
+    switch (channel) {
+        case 0:  return cfg->led_red;
+        case 1:  return cfg->led_green;
+        default: return cfg->led_blue;
+    }
+}
+
+/**
+ * @brief 寫入 LED 屬性檔（trigger、delay_on 等不常變動的屬性）
+ */
+static int led_write_attr(int channel, const char *attr, const char *value) {
+    char path[PLATFORM_CONFIG_PATH_MAX + 32];
+
+    snprintf(path, sizeof(path), "%s/%s", led_dir(config(), channel), attr);
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        set_error("Cannot open %s: %s", path, strerror(errno));
+        return PLATFORM_ERROR;
+    }
+    ssize_t len = (ssize_t)strlen(value);
+    ssize_t n = write(fd, value, (size_t)len);
+    close(fd);
+    if (n != len) {
+        set_error("Cannot write %s: %s", path, strerror(errno));
+        return PLATFORM_ERROR;
+    }
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 開啟 brightness 檔並讀取 max_brightness（開啟後保持，避免每次寫入都 open）
+ */
+static int led_open(int channel) {
+    char path[PLATFORM_CONFIG_PATH_MAX + 32];
+    char buf[16];
+    const char *dir = led_dir(config(), channel);
+
+    if (g_platform.led_fd[channel] >= 0) {
+        return PLATFORM_OK;
+    }
+
+    g_platform.led_max[channel] = 255;
+    snprintf(path, sizeof(path), "%s/max_brightness", dir);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        ssize_t n = read(fd, buf, sizeof(buf) - 1);
+        if (n > 0) {
+            buf[n] = '\0';
+            g_platform.led_max[channel] = (uint32_t)strtoul(buf, NULL, 10);
+        }
+        close(fd);
+    }
+
+    snprintf(path, sizeof(path), "%s/brightness", dir);
+    g_platform.led_fd[channel] = open(path, O_WRONLY | O_CLOEXEC);
+    if (g_platform.led_fd[channel] < 0) {
+        set_error("Cannot open %s: %s", path, strerror(errno));
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+    return PLATFORM_OK;
+}
+
+static void led_close(void) {
+    for (int i = 0; i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+        if (g_platform.led_fd[i] >= 0) {
+            close(g_platform.led_fd[i]);
+            g_platform.led_fd[i] = -1;
+        }
+    }
+}
+
+static int led_write_brightness(int channel, uint8_t value) {
+    char buf[16];
+
+    int ret = led_open(channel);
+    if (ret != PLATFORM_OK) {
+        return ret;
+    }
+
+    int len = snprintf(buf, sizeof(buf), "%u",
+                       (unsigned int)(value * g_platform.led_max[channel] / 255));
+    if (pwrite(g_platform.led_fd[channel], buf, (size_t)len, 0) != len) {
+        set_error("Cannot set LED brightness: %s", strerror(errno));
+        return PLATFORM_ERROR;
+    }
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 移除 trigger（恆亮顏色寫入前調用）
+ */
+static void led_stop_blink(void) {
+    if (!g_platform.led_blinking) {
+        return;
+    }
+    for (int i = 0; i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+        led_write_attr(i, "trigger", "none");
+    }
+    g_platform.led_blinking = false;
+    g_platform.led_traffic = false;
+}
+
+/**
+ * @brief 設定恆亮顏色
+ *
+ * 暫存器存取啟用時每個顏色一次暫存器寫入，否則寫入 sysfs brightness。
+ */
+static int led_apply_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    const uint8_t rgb[PLATFORM_CONFIG_LED_CHANNELS] = { r, g, b };
+    int ret = PLATFORM_OK;
+
+    led_stop_blink();
+
+    if (g_platform.mmio) {
+        mmio_set_led(r, g, b);
+    } else {
+        for (int i = 0; i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+            if (led_write_brightness(i, rgb[i]) != PLATFORM_OK) {
+                ret = PLATFORM_ERROR;
+            }
+        }
+    }
+
+    memcpy(g_platform.led_rgb, rgb, sizeof(rgb));
+    return ret;
+}
+
+/**
+ * @brief 以核心 timer trigger 閃爍，閃爍期間不佔用使用者空間 CPU
+ */
+static int led_apply_blink(uint8_t r, uint8_t g, uint8_t b, uint16_t period_ms) {
+    const uint8_t rgb[PLATFORM_CONFIG_LED_CHANNELS] = { r, g, b };
+    char delay[16];
+    int ret = PLATFORM_OK;
+
+    // timer trigger 直接取代 netdev trigger，流量指示隨之結束
+    g_platform.led_traffic = false;
+
+    snprintf(delay, sizeof(delay), "%u", (unsigned int)period_ms);
+    for (int i = 0; i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+        if (rgb[i] == 0) {
+            led_write_attr(i, "trigger", "none");
+            continue;
+        }
+        // timer trigger 以啟用時的 brightness 作為亮的亮度
+        if (led_write_brightness(i, rgb[i]) != PLATFORM_OK ||
+            led_write_attr(i, "trigger", "timer") != PLATFORM_OK ||
+            led_write_attr(i, "delay_on", delay) != PLATFORM_OK ||
+            led_write_attr(i, "delay_off", delay) != PLATFORM_OK) {
+            ret = PLATFORM_ERROR;
+        }
+    }
+
+    g_platform.led_blinking = true;
+    memcpy(g_platform.led_rgb, rgb, sizeof(rgb));
+    return ret;
+}
+
+/**
+ * @brief 以核心 netdev trigger 依 VPN 介面流量閃爍
+ *
+ * link 亮、rx / tx 閃爍，全部由核心處理，不需要在使用者空間輪詢介面計數器。
+ * 介面尚未建立時 trigger 會等待同名介面出現。
+ * 顏色沿用進入前的恆亮顏色，進入前為關閉或閃爍時使用 pattern 顏色。
+ */
+static int led_apply_traffic(uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t rgb[PLATFORM_CONFIG_LED_CHANNELS] = { r, g, b };
+    const char *ifname = config()->vpn_interface;
+    int ret = PLATFORM_OK;
+
+    // 重複進入（例如 platform_reset()）時保留最初的狀態
+    if (!g_platform.led_traffic) {
+        g_platform.led_saved.state = g_platform.led_state;
+        memcpy(g_platform.led_saved.rgb, g_platform.led_rgb, sizeof(g_platform.led_saved.rgb));
+        g_platform.led_saved.blinking = g_platform.led_blinking;
+        g_platform.led_saved.custom = g_platform.led_custom;
+    }
+    if (!g_platform.led_saved.blinking &&
+        (g_platform.led_saved.rgb[0] | g_platform.led_saved.rgb[1] | g_platform.led_saved.rgb[2])) {
+        memcpy(rgb, g_platform.led_saved.rgb, sizeof(rgb));
+    }
+
+    led_stop_blink();
+
+    for (int i = 0; i < PLATFORM_CONFIG_LED_CHANNELS; i++) {
+        if (rgb[i] == 0) {
+            continue;
+        }
+        // netdev trigger 同樣以啟用時的 brightness 作為亮的亮度
+        if (led_write_brightness(i, rgb[i]) != PLATFORM_OK ||
+            led_write_attr(i, "trigger", "netdev") != PLATFORM_OK ||
+            led_write_attr(i, "device_name", ifname) != PLATFORM_OK ||
+            led_write_attr(i, "link", "1") != PLATFORM_OK ||
+            led_write_attr(i, "rx", "1") != PLATFORM_OK ||
+            led_write_attr(i, "tx", "1") != PLATFORM_OK) {
+            ret = PLATFORM_ERROR;
+        }
+    }
+
+    g_platform.led_blinking = true;
+    g_platform.led_traffic = true;
+    memcpy(g_platform.led_rgb, rgb, sizeof(rgb));
+    return ret;
+}
+
+/* ============================================================================
+ * PS5（HDMI-CEC）
+ * ========================================================================== */
+
+#if PLATFORM_FEATURE_PS5
+/**
+ * @brief 宣告我方邏輯位址
+ *
+ * 邏輯位址屬於 adapter 而非檔案描述符，先前的行程宣告過（同一次開機）就直接沿用，
+ * 不必再於匯流排上輪詢候選位址。
+ */
+static int cec_claim(void) {
+    struct cec_log_addrs la;
+
+    memset(&la, 0, sizeof(la));
+    if (ioctl(g_platform.cec_fd, CEC_ADAP_G_LOG_ADDRS, &la) < 0) {
+        set_error("Cannot query CEC adapter: %s", strerror(errno));
+        return PLATFORM_ERROR;
+    }
+
+    if (la.num_log_addrs == 0) {
+        memset(&la, 0, sizeof(la));
+        la.cec_version = CEC_OP_CEC_VERSION_1_4;
+        la.num_log_addrs = 1;
+        la.vendor_id = CEC_VENDOR_ID_NONE;
+        strncpy(la.osd_name, "Gaming", sizeof(la.osd_name) - 1);
+        la.primary_device_type[0] = CEC_OP_PRIM_DEVTYPE_RECORD;
+        la.log_addr_type[0] = CEC_LOG_ADDR_TYPE_RECORD;  // 避開 PS5 使用的 playback 位址
+        la.all_device_types[0] = CEC_OP_ALL_DEVTYPE_RECORD;
+
+        // 阻塞直到核心完成位址宣告（HDMI 未連接時立即返回，位址仍無效）
+        if (ioctl(g_platform.cec_fd, CEC_ADAP_S_LOG_ADDRS, &la) < 0) {
+            set_error("Cannot claim CEC logical address: %s", strerror(errno));
+            return PLATFORM_ERROR;
+        }
+    }
+
+    if (la.log_addr[0] == CEC_LOG_ADDR_INVALID) {
+        set_error("CEC logical address not claimed (HDMI disconnected?)");
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+    g_platform.cec_self = la.log_addr[0];
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 管線化傳送：連續送出所有訊息，再統一收集結果
+ *
+ * fd 以非阻塞模式送出，核心立即返回並在匯流排上背靠背傳送，
+ * 結果（含 reply）依 sequence 經 CEC_RECEIVE 回報並寫回 msgs[i]。
+ * 核心傳送佇列滿時先收集一筆結果再繼續送出。
+ *
+ * 逾時採用校準的 cec_timeout_ms（帶 reply 的訊息再加上其 timeout），
+ * 每收到一筆結果重新計時；時限內未回報的訊息 tx_status 維持 0。
+ * 所有 CEC 傳送都經過此函數（單則訊息時 n 為 1）。
+ */
+static void cec_transmit_batch(struct cec_msg *msgs, int n) {
+    struct cec_msg result;
+    struct pollfd pfd = { .fd = g_platform.cec_fd, .events = POLLIN };
+    uint64_t window_us = g_platform.calib.cec_timeout_ms
+        ? g_platform.calib.cec_timeout_ms : DEFAULT_CEC_TIMEOUT_MS;
+    int flags = fcntl(g_platform.cec_fd, F_GETFL);
+    int sent = 0;
+    int done = 0;
+
+    uint32_t reply_ms = 0;
+    for (int i = 0; i < n; i++) {
+        if (msgs[i].reply && msgs[i].timeout > reply_ms) {
+            reply_ms = msgs[i].timeout;
+        }
+    }
+    window_us = (window_us + reply_ms) * 1000ull;
+    uint64_t deadline = now_us() + window_us;
+
+    fcntl(g_platform.cec_fd, F_SETFL, flags | O_NONBLOCK);
+
+    while (done < n) {
+        while (sent < n) {
+            if (ioctl(g_platform.cec_fd, CEC_TRANSMIT, &msgs[sent]) < 0) {
+                if (errno == EBUSY) {
+                    break;  // 佇列已滿
+                }
+                msgs[sent].sequence = 0;
+                msgs[sent].tx_status = CEC_TX_STATUS_ERROR;
+                done++;
+            }
+            sent++;
+        }
+
+        uint64_t now = now_us();
+        if (done >= n || now >= deadline ||
+            poll(&pfd, 1, (int)((deadline - now) / 1000) + 1) <= 0) {
+            break;
+        }
+
+        memset(&result, 0, sizeof(result));
+        if (ioctl(g_platform.cec_fd, CEC_RECEIVE, &result) < 0 || result.sequence == 0) {
+            continue;
+        }
+        for (int i = 0; i < sent; i++) {
+            if (msgs[i].sequence == result.sequence) {
+                msgs[i] = result;
+                done++;
+                deadline = now_us() + window_us;
+                break;
+            }
+        }
+    }
+
+    fcntl(g_platform.cec_fd, F_SETFL, flags);
+}
+
+/**
+ * @brief 完整探索匯流排拓撲
+ *
+ * 第一批：對所有邏輯位址送出 poll；
+ * 第二批：對有回應的裝置同時查詢實體位址與廠商 ID。
+ * 以 Sony 廠商 ID 的 playback 裝置作為 PS5。
+ */
+static void cec_discover(void) {
+    struct cec_msg msgs[CEC_NUM_LOG_ADDRS * 2];
+    uint8_t las[CEC_NUM_LOG_ADDRS];
+    uint32_t reply_timeout = g_platform.calib.ps5_reply_timeout_ms
+        ? g_platform.calib.ps5_reply_timeout_ms : DEFAULT_PS5_REPLY_TIMEOUT_MS;
+    uint64_t t0 = now_us();
+    int n = 0;
+
+    memset(g_platform.cec_devices, 0, sizeof(g_platform.cec_devices));
+
+    for (uint8_t la = 0; la < CEC_NUM_LOG_ADDRS; la++) {
+        if (la == g_platform.cec_self) {
+            continue;
+        }
+        memset(&msgs[n], 0, sizeof(msgs[n]));
+        cec_msg_init(&msgs[n], g_platform.cec_self, la);
+        las[n++] = la;
+    }
+    cec_transmit_batch(msgs, n);
+
+    int present = 0;
+    for (int i = 0; i < n; i++) {
+        if (msgs[i].tx_status & CEC_TX_STATUS_OK) {
+            g_platform.cec_devices[las[i]].present = true;
+            g_platform.cec_devices[las[i]].phys = CEC_PHYS_ADDR_INVALID;
+            g_platform.cec_devices[las[i]].vendor = CEC_VENDOR_ID_NONE;
+            las[present++] = las[i];
+        }
+    }
+
+    n = 0;
+    for (int i = 0; i < present; i++) {
+        memset(&msgs[n], 0, sizeof(msgs[n]));
+        cec_msg_init(&msgs[n], g_platform.cec_self, las[i]);
+        msgs[n].len = 2;
+        msgs[n].msg[1] = CEC_MSG_GIVE_PHYSICAL_ADDR;
+        msgs[n].reply = CEC_MSG_REPORT_PHYSICAL_ADDR;
+        msgs[n].timeout = reply_timeout;
+        n++;
+
+        memset(&msgs[n], 0, sizeof(msgs[n]));
+        cec_msg_init(&msgs[n], g_platform.cec_self, las[i]);
+        msgs[n].len = 2;
+        msgs[n].msg[1] = CEC_MSG_GIVE_DEVICE_VENDOR_ID;
+        msgs[n].reply = CEC_MSG_DEVICE_VENDOR_ID;
+        msgs[n].timeout = reply_timeout;
+        n++;
+    }
+    cec_transmit_batch(msgs, n);
+
+    for (int i = 0; i < n; i++) {
+        if (!(msgs[i].rx_status & CEC_RX_STATUS_OK)) {
+            continue;
+        }
+        uint8_t la = cec_msg_initiator(&msgs[i]);
+        if (msgs[i].msg[1] == CEC_MSG_REPORT_PHYSICAL_ADDR && msgs[i].len >= 4) {
+            g_platform.cec_devices[la].phys = (uint16_t)((msgs[i].msg[2] << 8) | msgs[i].msg[3]);
+        } else if (msgs[i].msg[1] == CEC_MSG_DEVICE_VENDOR_ID && msgs[i].len >= 5) {
+            g_platform.cec_devices[la].vendor =
+                ((uint32_t)msgs[i].msg[2] << 16) | (msgs[i].msg[3] << 8) | msgs[i].msg[4];
+        }
+    }
+
+    // 找不到 Sony playback 裝置時退回配置中的位址
+    g_platform.ps5_la = (uint8_t)config()->ps5_cec_addr;
+    const uint8_t playback[] = {
+        CEC_LOG_ADDR_PLAYBACK_1, CEC_LOG_ADDR_PLAYBACK_2, CEC_LOG_ADDR_PLAYBACK_3,
+    };
+    for (size_t i = 0; i < sizeof(playback); i++) {
+        if (g_platform.cec_devices[playback[i]].present &&
+            g_platform.cec_devices[playback[i]].vendor == CEC_VENDOR_SONY) {
+            g_platform.ps5_la = playback[i];
+            break;
+        }
+    }
+    g_platform.ps5_phys = g_platform.cec_devices[g_platform.ps5_la].present
+        ? g_platform.cec_devices[g_platform.ps5_la].phys : CEC_PHYS_ADDR_INVALID;
+
+    printf("[Platform OpenWrt] CEC discovery: %d device(s), PS5 at %u (%x.%x.%x.%x), %llums\n",
+           present, g_platform.ps5_la,
+           (g_platform.ps5_phys >> 12) & 0xf, (g_platform.ps5_phys >> 8) & 0xf,
+           (g_platform.ps5_phys >> 4) & 0xf, g_platform.ps5_phys & 0xf,
+           (unsigned long long)((now_us() - t0) / 1000));
+}
+
+/**
+ * @brief 載入保存的拓撲
+ *
+ * @return 保存時我方的邏輯位址，失敗返回 CEC_LOG_ADDR_INVALID
+ */
+static uint8_t cec_load_topology(void) {
+    char line[64];
+    unsigned int version = 0, self = CEC_LOG_ADDR_INVALID, ps5 = CEC_LOG_ADDR_INVALID;
+    unsigned int la, phys, vendor;
+
+    FILE *fp = fopen(PLATFORM_CEC_TOPOLOGY_PATH, "r");
+    if (!fp) {
+        return CEC_LOG_ADDR_INVALID;
+    }
+
+    memset(g_platform.cec_devices, 0, sizeof(g_platform.cec_devices));
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "version=%u", &version) == 1 ||
+            sscanf(line, "self=%u", &self) == 1 ||
+            sscanf(line, "ps5=%u", &ps5) == 1) {
+            continue;
+        }
+        if (sscanf(line, "device=%u,%x,%x", &la, &phys, &vendor) == 3 &&
+            la < CEC_NUM_LOG_ADDRS) {
+            g_platform.cec_devices[la].present = true;
+            g_platform.cec_devices[la].phys = (uint16_t)phys;
+            g_platform.cec_devices[la].vendor = vendor;
+        }
+    }
+    fclose(fp);
+
+    if (version != CEC_TOPOLOGY_VERSION || ps5 >= CEC_NUM_LOG_ADDRS ||
+        !g_platform.cec_devices[ps5].present) {
+        return CEC_LOG_ADDR_INVALID;
+    }
+    g_platform.ps5_la = (uint8_t)ps5;
+    g_platform.ps5_phys = g_platform.cec_devices[ps5].phys;
+    return (uint8_t)self;
+}
+
+static void cec_save_topology(void) {
+    char tmp_path[] = PLATFORM_CEC_TOPOLOGY_PATH ".tmp";
+    char dir[] = PLATFORM_CEC_TOPOLOGY_PATH;
+
+    char *slash = strrchr(dir, '/');
+    if (slash && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    FILE *fp = fopen(tmp_path, "w");
+    if (!fp) {
+        return;
+    }
+    fprintf(fp, "version=%u\n", CEC_TOPOLOGY_VERSION);
+    fprintf(fp, "self=%u\n", g_platform.cec_self);
+    fprintf(fp, "ps5=%u\n", g_platform.ps5_la);
+    for (unsigned int la = 0; la < CEC_NUM_LOG_ADDRS; la++) {
+        if (g_platform.cec_devices[la].present) {
+            fprintf(fp, "device=%u,%04x,%06x\n", la,
+                    g_platform.cec_devices[la].phys, g_platform.cec_devices[la].vendor);
+        }
+    }
+    if (fclose(fp) != 0 || rename(tmp_path, PLATFORM_CEC_TOPOLOGY_PATH) != 0) {
+        unlink(tmp_path);
+    }
+}
+
+/**
+ * @brief 以一次定向查詢驗證保存的 PS5 位址
+ *
+ * 向保存的 PS5 邏輯位址查詢實體位址，回覆與保存值一致即視為拓撲未變。
+ */
+static bool cec_validate_topology(void) {
+    struct cec_msg msg;
+
+    if (g_platform.ps5_phys == CEC_PHYS_ADDR_INVALID) {
+        return false;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    cec_msg_init(&msg, g_platform.cec_self, g_platform.ps5_la);
+    msg.len = 2;
+    msg.msg[1] = CEC_MSG_GIVE_PHYSICAL_ADDR;
+    msg.reply = CEC_MSG_REPORT_PHYSICAL_ADDR;
+    msg.timeout = g_platform.calib.ps5_reply_timeout_ms
+        ? g_platform.calib.ps5_reply_timeout_ms : DEFAULT_PS5_REPLY_TIMEOUT_MS;
+
+    cec_transmit_batch(&msg, 1);
+    return (msg.rx_status & CEC_RX_STATUS_OK) && msg.len >= 4 &&
+           ((msg.msg[2] << 8) | msg.msg[3]) == g_platform.ps5_phys;
+}
+
+/**
+ * @brief 開啟 CEC 並建立 PS5 位址
+ *
+ * 保存的拓撲在我方邏輯位址相同且定向查詢驗證通過時直接沿用，
+ * 否則重新探索並保存。
+ */
+static int cec_open(void) {
+    const platform_config_t *cfg = config();
+
+    if (g_platform.cec_fd >= 0 && g_platform.ps5_la != CEC_LOG_ADDR_INVALID) {
+        return PLATFORM_OK;
+    }
+
+    if (g_platform.cec_fd < 0) {
+        g_platform.cec_fd = open(cfg->cec_device, O_RDWR | O_CLOEXEC);
+        if (g_platform.cec_fd < 0) {
+            set_error("Cannot open %s: %s", cfg->cec_device, strerror(errno));
+            return PLATFORM_ERROR_NOT_FOUND;
+        }
+    }
+
+    int ret = cec_claim();
+    if (ret != PLATFORM_OK) {
+        return ret;  // fd 保留，下次調用時重試宣告
+    }
+
+    uint8_t cached_self = cec_load_topology();
+    if (cached_self == g_platform.cec_self && cec_validate_topology()) {
+        printf("[Platform OpenWrt] CEC topology from cache, PS5 at %u\n", g_platform.ps5_la);
+        return PLATFORM_OK;
+    }
+
+    cec_discover();
+    cec_save_topology();
+    return PLATFORM_OK;
+}
+
+static void cec_close(void) {
+    // 不解除邏輯位址宣告，讓其他行程直接沿用
+    if (g_platform.cec_fd >= 0) {
+        close(g_platform.cec_fd);
+        g_platform.cec_fd = -1;
+    }
+    g_platform.ps5_la = CEC_LOG_ADDR_INVALID;
+    g_platform.ps5_phys = CEC_PHYS_ADDR_INVALID;
+    g_platform.ps5_power_us = 0;
+}
+
+/**
+ * @brief 送出一則訊息（等待傳送完成，最長 cec_timeout_ms）
+ */
+static bool cec_send(uint8_t dest, const uint8_t *payload, uint8_t len) {
+    struct cec_msg msg;
+
+    memset(&msg, 0, sizeof(msg));
+    cec_msg_init(&msg, g_platform.cec_self, dest);
+    memcpy(&msg.msg[1], payload, len);
+    msg.len = (uint32_t)(1 + len);
+    cec_transmit_batch(&msg, 1);
+    return (msg.tx_status & CEC_TX_STATUS_OK) != 0;
+}
+#endif /* PLATFORM_FEATURE_PS5 */
+
+/* ============================================================================
+ * 延遲 span
+ * ========================================================================== */
+
+#define SPAN_SLOTS          8                       // 同時進行的 span 上限
+#define SPAN_TIMEOUT_US     (60ull * 1000000ull)    // 超過即視為未完成
+#define SPAN_REOPEN_US      50000                   // 主按鈕上次邊緣後此時間內的按下沿用同一 span
+#define SPAN_SUB_BITS       3                       // 每個 2 的冪次再分 8 桶，誤差 ≤ 12.5%
+#define SPAN_DIRECT         (1u << (SPAN_SUB_BITS + 2))
+#define SPAN_BUCKETS        (SPAN_DIRECT + (32 - SPAN_SUB_BITS - 2) * (1u << SPAN_SUB_BITS))
+
+typedef struct {
+    uint32_t id;            // 0 表示空位
+    uint64_t start_us;      // 按下時間（核心事件時間）
+    uint64_t wake_us;       // 喚醒送出時間，0 表示尚未喚醒
+    bool vpn_done;
+    bool ps5_done;
+} span_slot_t;
+
+typedef struct {
+    uint32_t buckets[SPAN_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+} span_hist_t;
+
+static struct {
+    span_slot_t slots[SPAN_SLOTS];
+    uint32_t next_id;
+    uint32_t main_span;         // 主按鈕最近一次按下的 span
+    uint64_t main_edge_us;      // 主按鈕最近一次邊緣（核心事件時間）
+    span_hist_t hist[PLATFORM_SPAN_LEG_COUNT];
+    uint32_t aborted;
+    uint32_t expired;
+} g_spans;
+
+static uint32_t span_bucket(uint32_t us) {
+    if (us < SPAN_DIRECT) {
+        return us;
+    }
+    uint32_t e = 31u - (uint32_t)__builtin_clz(us);
+    return SPAN_DIRECT + (e - SPAN_SUB_BITS - 2) * (1u << SPAN_SUB_BITS) +
+           ((us >> (e - SPAN_SUB_BITS)) & ((1u << SPAN_SUB_BITS) - 1));
+}
+
+/**
+ * @brief 桶內最大值（百分位數取上界，不會低估延遲）
+ */
+static uint32_t span_bucket_upper(uint32_t index) {
+    if (index < SPAN_DIRECT) {
+        return index;
+    }
+    uint32_t k = index - SPAN_DIRECT;
+    uint32_t shift = k >> SPAN_SUB_BITS;  // e - SPAN_SUB_BITS - 2
+    uint64_t lower = (uint64_t)((1u << SPAN_SUB_BITS) + (k & ((1u << SPAN_SUB_BITS) - 1))) << (shift + 2);
+    uint64_t upper = lower + (1ull << (shift + 2)) - 1;
+    return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+}
+
+static void span_record(platform_span_leg_t leg, uint64_t start_us, uint64_t end_us) {
+    span_hist_t *h = &g_spans.hist[leg];
+    uint64_t d = end_us > start_us ? end_us - start_us : 0;
+    uint32_t us = d > UINT32_MAX ? UINT32_MAX : (uint32_t)d;
+
+    h->buckets[span_bucket(us)]++;
+    h->count++;
+    if (us > h->max_us) {
+        h->max_us = us;
+    }
+}
+
+static uint32_t span_percentile(const span_hist_t *h, uint32_t permille) {
+    uint64_t rank = ((uint64_t)h->count * permille + 999) / 1000;  // 無條件進位
+    uint64_t seen = 0;
+
+    if (rank == 0) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < SPAN_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = span_bucket_upper(i);
+            return upper < h->max_us ? upper : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+/**
+ * @brief 找出進行中的 span，逾時的 span 在此回收
+ */
+static span_slot_t *span_find(uint32_t id, uint64_t now) {
+    for (int i = 0; i < SPAN_SLOTS; i++) {
+        span_slot_t *s = &g_spans.slots[i];
+        if (s->id && now > s->start_us && now - s->start_us > SPAN_TIMEOUT_US) {
+            s->id = 0;
+            g_spans.expired++;
+        }
+    }
+    if (id == PLATFORM_SPAN_NONE) {
+        return NULL;
+    }
+    for (int i = 0; i < SPAN_SLOTS; i++) {
+        if (g_spans.slots[i].id == id) {
+            return &g_spans.slots[i];
+        }
+    }
+    return NULL;
+}
+
+#if PLATFORM_FEATURE_BUTTON
+/**
+ * @brief 開啟 span，空位用完時擠出最舊的 span
+ */
+static uint32_t span_open(uint64_t start_us) {
+    span_slot_t *slot = NULL;
+
+    span_find(PLATFORM_SPAN_NONE, now_us());
+    for (int i = 0; i < SPAN_SLOTS; i++) {
+        span_slot_t *s = &g_spans.slots[i];
+        if (!s->id) {
+            slot = s;
+            break;
+        }
+        if (!slot || s->start_us < slot->start_us) {
+            slot = s;
+        }
+    }
+    if (slot->id) {
+        g_spans.expired++;
+    }
+
+    // 以 pid 區隔各行程的 id，其他行程的 span_id 不會對應到本行程的 span
+    if (g_spans.next_id == 0) {
+        g_spans.next_id = (uint32_t)getpid() << 16;
+    }
+    if (++g_spans.next_id == PLATFORM_SPAN_NONE) {
+        g_spans.next_id = 1;
+    }
+    memset(slot, 0, sizeof(*slot));
+    slot->id = g_spans.next_id;
+    slot->start_us = start_us;
+    return slot->id;
+}
+
+/**
+ * @brief 取得按鈕事件的 span
+ *
+ * 只有主按鈕（觸發連線與喚醒）開啟 span。
+ * 距上次邊緣不到 SPAN_REOPEN_US 的按下視為彈跳，沿用原本的 span，起點保持第一次按下。
+ */
+static uint32_t span_on_button(uint32_t button, platform_button_state_t state,
+                               uint64_t event_us) {
+    if (button != PLATFORM_BUTTON_MAIN) {
+        return PLATFORM_SPAN_NONE;
+    }
+
+    bool bounce = g_spans.main_span && event_us - g_spans.main_edge_us < SPAN_REOPEN_US;
+    g_spans.main_edge_us = event_us;
+    if (state == BUTTON_PRESSED && !bounce) {
+        g_spans.main_span = span_open(event_us);
+    }
+    return g_spans.main_span;
+}
+#endif
+
+static void span_on_led(uint32_t id, platform_led_state_t state) {
+    uint64_t now = now_us();
+    span_slot_t *s = span_find(id, now);
+
+    if (!s) {
+        return;
+    }
+
+    switch (state) {
+        case LED_STATE_VPN_CONNECTED:
+        case LED_STATE_VPN_TRAFFIC:
+            if (!s->vpn_done) {
+                s->vpn_done = true;
+                span_record(PLATFORM_SPAN_VPN, s->start_us, now);
+            }
+            break;
+        case LED_STATE_PS5_ON:
+            if (!s->ps5_done) {
+                s->ps5_done = true;
+                if (s->wake_us) {
+                    span_record(PLATFORM_SPAN_PS5, s->wake_us, now);
+                }
+            }
+            break;
+        case LED_STATE_VPN_ERROR:
+        case LED_STATE_ERROR:
+        case LED_STATE_SYSTEM_ERROR:
+            s->id = 0;
+            g_spans.aborted++;
+            return;
+        default:
+            return;  // 中間狀態只延續 span
+    }
+
+    if (s->vpn_done && s->ps5_done) {
+        span_record(PLATFORM_SPAN_TOTAL, s->start_us, now);
+        s->id = 0;
+    }
+}
+
+#if PLATFORM_FEATURE_PS5
+static void span_on_wake(uint32_t id) {
+    uint64_t now = now_us();
+    span_slot_t *s = span_find(id, now);
+
+    if (s && !s->wake_us) {
+        s->wake_us = now;
+        span_record(PLATFORM_SPAN_WAKE, s->start_us, now);
+    }
+}
+#endif
+
+/* ============================================================================
+ * 硬體校準
+ * ========================================================================== */
+
+/**
+ * @brief 取中位數（會就地排序樣本）
+ *
+ * 中位數可排除單次排程延遲造成的極端值。
+ * 結果至少為 1：0 代表「未量測」，不足 1 微秒的路徑（如暫存器讀取）仍須視為已量測。
+ */
+static uint32_t median_us(uint32_t *samples, int n) {
+    for (int i = 1; i < n; i++) {
+        uint32_t v = samples[i];
+        int j = i - 1;
+        while (j >= 0 && samples[j] > v) {
+            samples[j + 1] = samples[j];
+            j--;
+        }
+        samples[j + 1] = v;
+    }
+    return samples[n / 2] ? samples[n / 2] : 1;
+}
+
+/**
+ * @brief 量測 LED sysfs 寫入延遲
+ *
+ * 讀出目前亮度後原值寫回，量測期間 LED 不會有可見變化。
+ */
+static int probe_sysfs_write(uint32_t *out_us) {
+    uint32_t samples[CALIB_SAMPLES];
+    char path[PLATFORM_CONFIG_PATH_MAX + 16];
+    char value[16];
+
+    snprintf(path, sizeof(path), "%s/brightness", config()->led_green);
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    ssize_t len = pread(fd, value, sizeof(value), 0);
+    if (len <= 0) {
+        close(fd);
+        return PLATFORM_ERROR;
+    }
+
+    for (int i = 0; i < CALIB_SAMPLES; i++) {
+        uint64_t t0 = now_us();
+        if (pwrite(fd, value, (size_t)len, 0) != len) {
+            close(fd);
+            return PLATFORM_ERROR;
+        }
+        samples[i] = (uint32_t)(now_us() - t0);
+    }
+
+    close(fd);
+    *out_us = median_us(samples, CALIB_SAMPLES);
+    return PLATFORM_OK;
+}
+
+#if PLATFORM_FEATURE_BUTTON
+/**
+ * @brief 量測按鈕 GPIO 讀取延遲
+ *
+ * 直接量測 platform_get_buttons() 使用的同一個 line request。
+ */
+static int probe_gpio_read(uint32_t *out_us) {
+    uint32_t samples[CALIB_SAMPLES];
+    uint32_t mask;
+
+    for (int i = 0; i < CALIB_SAMPLES; i++) {
+        uint64_t t0 = now_us();
+        int ret = platform_get_buttons(&mask);
+        if (ret != PLATFORM_OK) {
+            return ret;
+        }
+        samples[i] = (uint32_t)(now_us() - t0);
+    }
+
+    *out_us = median_us(samples, CALIB_SAMPLES);
+    return PLATFORM_OK;
+}
+#endif /* PLATFORM_FEATURE_BUTTON */
+
+#if PLATFORM_FEATURE_PS5
+/**
+ * @brief 量測 CEC 來回時間與 PS5 回應時間
+ *
+ * - 來回時間：對 PS5 邏輯位址發送 poll 訊框，量測到收到 ACK/NACK 為止
+ * - 回應時間：發送 GIVE_DEVICE_POWER_STATUS，以 tx_ts/rx_ts 計算回覆延遲
+ *
+ * @note 需要 CEC adapter 已設定邏輯位址，否則無法發送
+ */
+static int probe_cec(uint32_t *rtt_us, uint32_t *response_us) {
+    uint32_t samples[CALIB_CEC_SAMPLES];
+    struct cec_log_addrs log_addrs;
+    struct cec_msg msg;
+    int n = 0;
+    const platform_config_t *cfg = config();
+    uint8_t ps5 = (g_platform.ps5_la != CEC_LOG_ADDR_INVALID)
+        ? g_platform.ps5_la : (uint8_t)cfg->ps5_cec_addr;
+
+    int fd = open(cfg->cec_device, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    memset(&log_addrs, 0, sizeof(log_addrs));
+    if (ioctl(fd, CEC_ADAP_G_LOG_ADDRS, &log_addrs) < 0 ||
+        log_addrs.num_log_addrs == 0 ||
+        log_addrs.log_addr[0] == CEC_LOG_ADDR_INVALID) {
+        close(fd);
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+    uint8_t self = log_addrs.log_addr[0];
+
+    for (int i = 0; i < CALIB_CEC_SAMPLES; i++) {
+        memset(&msg, 0, sizeof(msg));
+        cec_msg_init(&msg, self, ps5);
+        uint64_t t0 = now_us();
+        if (ioctl(fd, CEC_TRANSMIT, &msg) < 0) {
+            break;
+        }
+        // NACK 同樣代表訊框已完整走完匯流排
+        if (msg.tx_status & (CEC_TX_STATUS_OK | CEC_TX_STATUS_NACK)) {
+            samples[n++] = (uint32_t)(now_us() - t0);
+        }
+    }
+    if (n > 0) {
+        *rtt_us = median_us(samples, n);
+    }
+
+    n = 0;
+    for (int i = 0; i < CALIB_CEC_SAMPLES; i++) {
+        memset(&msg, 0, sizeof(msg));
+        cec_msg_init(&msg, self, ps5);
+        msg.len = 2;
+        msg.msg[1] = CEC_MSG_GIVE_DEVICE_POWER_STATUS;
+        msg.reply = CEC_MSG_REPORT_POWER_STATUS;
+        msg.timeout = DEFAULT_PS5_REPLY_TIMEOUT_MS * 2;
+        if (ioctl(fd, CEC_TRANSMIT, &msg) < 0) {
+            break;
+        }
+        if ((msg.rx_status & CEC_RX_STATUS_OK) && msg.rx_ts > msg.tx_ts) {
+            samples[n++] = (uint32_t)((msg.rx_ts - msg.tx_ts) / 1000u);
+        } else if (!(msg.tx_status & CEC_TX_STATUS_OK)) {
+            break;  // PS5 不在匯流排上，不必重試
+        }
+    }
+    if (n > 0) {
+        *response_us = median_us(samples, n);
+    }
+
+    close(fd);
+    return (*rtt_us || *response_us) ? PLATFORM_OK : PLATFORM_ERROR;
+}
+#endif /* PLATFORM_FEATURE_PS5 */
+
+/**
+ * @brief 由量測值推導執行策略
+ *
+ * - 快取 TTL：PS5 查詢成本的 4 倍，讓查詢佔用的匯流排時間不超過 25%
+ * - 輪詢下限：GPIO 讀取成本的 100 倍，輪詢 CPU 佔用不超過 1%
+ * - 輪詢上限：下限的 5 倍，但不超過 100ms（按鈕反應的可感知門檻）
+ * - 逾時：量測值的 3 倍，保留匯流排重送與負載波動的餘裕
+ *
+ * 配置中非 0 的策略值優先於推導結果。
+ */
+static void derive_policies(platform_calibration_t *c) {
+    const platform_config_t *cfg = config();
+
+    c->cache_ttl_ms = c->ps5_response_us
+        ? clamp_u32(c->ps5_response_us * 4 / 1000, 500, 5000)
+        : DEFAULT_CACHE_TTL_MS;
+
+    c->poll_min_ms = c->gpio_read_us
+        ? clamp_u32(c->gpio_read_us * 100 / 1000, 5, 50)
+        : DEFAULT_POLL_MIN_MS;
+    c->poll_max_ms = c->gpio_read_us
+        ? clamp_u32(c->poll_min_ms * 5, 50, 100)
+        : DEFAULT_POLL_MAX_MS;
+
+    c->cec_timeout_ms = c->cec_rtt_us
+        ? clamp_u32(c->cec_rtt_us * 3 / 1000, 200, 2000)
+        : DEFAULT_CEC_TIMEOUT_MS;
+    c->ps5_reply_timeout_ms = c->ps5_response_us
+        ? clamp_u32(c->ps5_response_us * 3 / 1000, 300, 3000)
+        : DEFAULT_PS5_REPLY_TIMEOUT_MS;
+
+    if (cfg->cache_ttl_ms) c->cache_ttl_ms = cfg->cache_ttl_ms;
+    if (cfg->poll_min_ms) c->poll_min_ms = cfg->poll_min_ms;
+    if (cfg->poll_max_ms) c->poll_max_ms = cfg->poll_max_ms;
+    if (cfg->cec_timeout_ms) c->cec_timeout_ms = cfg->cec_timeout_ms;
+    if (cfg->ps5_reply_timeout_ms) c->ps5_reply_timeout_ms = cfg->ps5_reply_timeout_ms;
+    if (c->poll_max_ms < c->poll_min_ms) c->poll_max_ms = c->poll_min_ms;
+}
+
+/**
+ * @brief 載入保存的量測結果
+ *
+ * 只保存量測值，策略每次載入時重新推導，
+ * 因此推導規則更新後舊的量測結果仍然有效。
+ */
+static int load_calibration(platform_calibration_t *c) {
+    char key[32];
+    unsigned int value;
+    unsigned int version = 0;
+
+    FILE *fp = fopen(PLATFORM_CALIBRATION_PATH, "r");
+    if (!fp) {
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    memset(c, 0, sizeof(*c));
+    while (fscanf(fp, " %31[^=]=%u", key, &value) == 2) {
+        if (strcmp(key, "version") == 0) version = value;
+        else if (strcmp(key, "sysfs_write_us") == 0) c->sysfs_write_us = value;
+        else if (strcmp(key, "gpio_read_us") == 0) c->gpio_read_us = value;
+        else if (strcmp(key, "cec_rtt_us") == 0) c->cec_rtt_us = value;
+        else if (strcmp(key, "ps5_response_us") == 0) c->ps5_response_us = value;
+    }
+    fclose(fp);
+
+    if (version != CALIB_FILE_VERSION) {
+        return PLATFORM_ERROR;
+    }
+
+    derive_policies(c);
+    return PLATFORM_OK;
+}
+
+/**
+ * @brief 保存量測結果（先寫暫存檔再 rename，避免斷電留下半個檔案）
+ */
+static int save_calibration(const platform_calibration_t *c) {
+    char tmp_path[] = PLATFORM_CALIBRATION_PATH ".tmp";
+    char dir[] = PLATFORM_CALIBRATION_PATH;
+
+    char *slash = strrchr(dir, '/');
+    if (slash && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    FILE *fp = fopen(tmp_path, "w");
+    if (!fp) {
+        set_error("Cannot write %s: %s", tmp_path, strerror(errno));
+        return PLATFORM_ERROR;
+    }
+
+    fprintf(fp, "version=%u\n", CALIB_FILE_VERSION);
+    fprintf(fp, "sysfs_write_us=%u\n", c->sysfs_write_us);
+    fprintf(fp, "gpio_read_us=%u\n", c->gpio_read_us);
+    fprintf(fp, "cec_rtt_us=%u\n", c->cec_rtt_us);
+    fprintf(fp, "ps5_response_us=%u\n", c->ps5_response_us);
+
+    if (fclose(fp) != 0 || rename(tmp_path, PLATFORM_CALIBRATION_PATH) != 0) {
+        set_error("Cannot save calibration: %s", strerror(errno));
+        unlink(tmp_path);
+        return PLATFORM_ERROR;
+    }
+    return PLATFORM_OK;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ========================================================================== */
 
 int platform_init(void) {
-    // TODO: 硬體團隊實作
-    printf("[Platform OpenWrt] TODO: Implement platform_init()\n");
+    if (g_platform.initialized) {
+        return PLATFORM_OK;
+    }
+
+    const platform_config_t *cfg = config();
+    printf("[Platform OpenWrt] Config generation %u (%s)\n", cfg->header.generation,
+           cfg == &g_config.defaults ? "built-in defaults" : PLATFORM_CONFIG_BLOB_PATH);
+
+    // 低延遲模式（可選），須在校準前開啟，GPIO 量測才會反映實際讀取路徑
+    mmio_open();
+
+    // 先載入保存的校準結果，CEC 探索即套用校準後的逾時；沒有時暫用預設策略
+    bool calibrated = load_calibration(&g_platform.calib) == PLATFORM_OK;
+    if (!calibrated) {
+        derive_policies(&g_platform.calib);
+    }
+
+#if PLATFORM_FEATURE_PS5
+    // 宣告 CEC 位址並建立 PS5 拓撲（校準的 CEC 量測需要已宣告的位址）
+    cec_open();
+#endif
+
+    // 沒有保存的校準結果時（首次開機或更換硬體）執行一次校準
+    if (!calibrated && platform_calibrate() != PLATFORM_OK) {
+        derive_policies(&g_platform.calib);
+    }
+
+    g_platform.initialized = true;
+    printf("[Platform OpenWrt] Initialized (cache TTL %ums, poll %u-%ums)\n",
+           g_platform.calib.cache_ttl_ms,
+           g_platform.calib.poll_min_ms, g_platform.calib.poll_max_ms);
     return PLATFORM_OK;
 }
 
 void platform_cleanup(void) {
-    // TODO: 硬體團隊實作
+#if PLATFORM_FEATURE_BUTTON
+    button_close();
+#endif
+    mmio_close();
+    led_close();
+#if PLATFORM_FEATURE_PS5
+    cec_close();
+#endif
+    config_release();
+    g_platform.initialized = false;
 }
 
 const char* platform_get_version(void) {
-    return "OpenWrt-TODO-v1.0";
+#if !PLATFORM_FEATURE_PS5
+    return "OpenWrt-v" PLATFORM_VERSION "-client";
+#elif !PLATFORM_FEATURE_BUTTON
+    return "OpenWrt-v" PLATFORM_VERSION "-server";
+#else
+    return "OpenWrt-v" PLATFORM_VERSION;
+#endif
 }
 
 const char* platform_get_device_type(void) {
+    // 單一角色的變體套件在編譯期即確定裝置類型
+#if !PLATFORM_FEATURE_PS5
+    return "client";
+#elif !PLATFORM_FEATURE_BUTTON
+    return "server";
+#endif
+
     // TODO: 硬體團隊實作
     // 可選方案:
     // 1. 讀取 ADC
@@ -40,35 +1781,369 @@ const char* platform_get_device_type(void) {
 }
 
 int platform_set_led_state(platform_led_state_t state) {
-    // TODO: 硬體團隊實作
-    return PLATFORM_OK;
+    if ((unsigned int)state >= sizeof(k_led_patterns) / sizeof(k_led_patterns[0])) {
+        set_error("Invalid LED state: %d", state);
+        return PLATFORM_ERROR_PARAM;
+    }
+
+    int ret;
+    if (k_led_patterns[state].netdev) {
+        ret = led_apply_traffic(k_led_patterns[state].r, k_led_patterns[state].g,
+                                k_led_patterns[state].b);
+    } else if (k_led_patterns[state].blink_ms) {
+        ret = led_apply_blink(k_led_patterns[state].r, k_led_patterns[state].g,
+                              k_led_patterns[state].b, k_led_patterns[state].blink_ms);
+    } else {
+        ret = led_apply_rgb(k_led_patterns[state].r, k_led_patterns[state].g,
+                            k_led_patterns[state].b);
+    }
+    g_platform.led_state = state;
+    g_platform.led_custom = false;
+    return ret;
+}
+
+int platform_clear_led_traffic(void) {
+    if (!g_platform.led_traffic) {
+        return PLATFORM_OK;
+    }
+
+    // 移除 netdev trigger 後核心會關閉 LED，必須重新寫入原本的顏色
+    if (g_platform.led_saved.blinking) {
+        return platform_set_led_state(g_platform.led_saved.state);
+    }
+    int ret = led_apply_rgb(g_platform.led_saved.rgb[0], g_platform.led_saved.rgb[1],
+                            g_platform.led_saved.rgb[2]);
+    g_platform.led_state = g_platform.led_saved.state;
+    g_platform.led_custom = g_platform.led_saved.custom;
+    return ret;
+}
+
+int platform_set_led_state_span(platform_led_state_t state, uint32_t span_id) {
+    int ret = platform_set_led_state(state);
+    if (ret == PLATFORM_OK) {
+        span_on_led(span_id, state);
+    }
+    return ret;
 }
 
 int platform_set_led_rgb(uint8_t r, uint8_t g, uint8_t b) {
-    // TODO: 硬體團隊實作
+    g_platform.led_custom = true;
+    return led_apply_rgb(r, g, b);
+}
+
+int platform_get_led(platform_led_info_t *info) {
+    if (!info) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    info->state = g_platform.led_state;
+    info->custom = g_platform.led_custom;
+    info->r = g_platform.led_rgb[0];
+    info->g = g_platform.led_rgb[1];
+    info->b = g_platform.led_rgb[2];
     return PLATFORM_OK;
 }
 
 platform_button_state_t platform_get_button_state(void) {
-    // TODO: 硬體團隊實作
+#if PLATFORM_FEATURE_BUTTON
+    uint32_t mask;
+
+    if (platform_get_buttons(&mask) != PLATFORM_OK) {
+        return BUTTON_UNAVAILABLE;  // 不把讀取失敗當成放開
+    }
+    if (mask & (1u << PLATFORM_BUTTON_MAIN)) {
+        return BUTTON_PRESSED;
+    }
+#endif
     return BUTTON_RELEASED;
 }
 
+int platform_get_buttons(uint32_t *mask) {
+    if (!mask) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    *mask = 0;
+
+#if PLATFORM_FEATURE_BUTTON
+    struct gpio_v2_line_values values;
+
+    // 低延遲模式：一次暫存器讀取，不經過系統調用
+    if (g_platform.mmio) {
+        *mask = mmio_get_buttons();
+        return PLATFORM_OK;
+    }
+
+    int ret = button_open();
+    if (ret != PLATFORM_OK) {
+        return ret;
+    }
+
+    // 一次 ioctl 同時取樣所有按鈕
+    values.bits = 0;
+    values.mask = (g_platform.button_count >= 64)
+        ? ~0ULL : ((1ULL << g_platform.button_count) - 1);
+    if (ioctl(g_platform.button_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+        set_error("Cannot read buttons: %s", strerror(errno));
+        return PLATFORM_ERROR;
+    }
+
+    *mask = (uint32_t)values.bits;
+#endif
+    return PLATFORM_OK;
+}
+
+int platform_get_button_fd(void) {
+#if PLATFORM_FEATURE_BUTTON
+    if (button_open() != PLATFORM_OK || button_enable_events() != PLATFORM_OK) {
+        return -1;
+    }
+    return g_platform.button_fd;
+#else
+    return -1;
+#endif
+}
+
+void platform_release_buttons(void) {
+#if PLATFORM_FEATURE_BUTTON
+    button_close();
+#endif
+}
+
+int platform_read_button_event(platform_button_event_t *event) {
+    if (!event) {
+        return PLATFORM_ERROR_PARAM;
+    }
+
+#if PLATFORM_FEATURE_BUTTON
+    struct gpio_v2_line_event ev;
+
+    if (platform_get_button_fd() < 0) {
+        return PLATFORM_ERROR;
+    }
+
+    for (;;) {
+        ssize_t n = read(g_platform.button_fd, &ev, sizeof(ev));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                return PLATFORM_ERROR_NOT_FOUND;
+            }
+            set_error("Cannot read button event: %s", strerror(errno));
+            return PLATFORM_ERROR;
+        }
+        if (n != (ssize_t)sizeof(ev)) {
+            return PLATFORM_ERROR;
+        }
+
+        for (uint32_t i = 0; i < g_platform.button_count; i++) {
+            if (g_platform.button_lines[i] == ev.offset) {
+                event->button = i;
+                event->state = (ev.id == GPIO_V2_LINE_EVENT_RISING_EDGE)
+                    ? BUTTON_PRESSED : BUTTON_RELEASED;
+                event->timestamp_ns = ev.timestamp_ns;
+                event->span_id = span_on_button(i, event->state, ev.timestamp_ns / 1000);
+                return PLATFORM_OK;
+            }
+        }
+        // 不屬於任何按鈕的線路（理論上不會發生），略過
+    }
+#else
+    return PLATFORM_ERROR_NOT_FOUND;
+#endif
+}
+
 platform_ps5_power_t platform_get_ps5_power(void) {
-    // TODO: 硬體團隊實作
+#if PLATFORM_FEATURE_PS5
+    struct cec_msg msg;
+    uint32_t ttl_ms = g_platform.calib.cache_ttl_ms
+        ? g_platform.calib.cache_ttl_ms : DEFAULT_CACHE_TTL_MS;
+    uint64_t now = now_us();
+
+    if (g_platform.ps5_power_us && now - g_platform.ps5_power_us < ttl_ms * 1000ull) {
+        return g_platform.ps5_power;
+    }
+    if (cec_open() != PLATFORM_OK) {
+        return PLATFORM_PS5_UNKNOWN;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    cec_msg_init(&msg, g_platform.cec_self, g_platform.ps5_la);
+    msg.len = 2;
+    msg.msg[1] = CEC_MSG_GIVE_DEVICE_POWER_STATUS;
+    msg.reply = CEC_MSG_REPORT_POWER_STATUS;
+    msg.timeout = g_platform.calib.ps5_reply_timeout_ms
+        ? g_platform.calib.ps5_reply_timeout_ms : DEFAULT_PS5_REPLY_TIMEOUT_MS;
+
+    platform_ps5_power_t power = PLATFORM_PS5_UNKNOWN;
+    cec_transmit_batch(&msg, 1);
+    if ((msg.rx_status & CEC_RX_STATUS_OK) && msg.len >= 3) {
+        switch (msg.msg[2]) {
+            case CEC_OP_POWER_STATUS_ON:
+            case CEC_OP_POWER_STATUS_TO_STANDBY:
+                power = PLATFORM_PS5_ON;
+                break;
+            case CEC_OP_POWER_STATUS_STANDBY:
+            case CEC_OP_POWER_STATUS_TO_ON:   // 開機尚未完成
+                power = PLATFORM_PS5_STANDBY;
+                break;
+        }
+    } else if (msg.tx_status & CEC_TX_STATUS_NACK) {
+        power = PLATFORM_PS5_OFF;  // 匯流排上沒有回應（完全關機或拔除）
+    }
+
+    g_platform.ps5_power = power;
+    g_platform.ps5_power_us = now;
+    return power;
+#else
     return PLATFORM_PS5_UNKNOWN;
+#endif
 }
 
 int platform_send_ps5_wake(void) {
-    // TODO: 硬體團隊實作
+#if PLATFORM_FEATURE_PS5
+    bool sent = false;
+
+    int ret = cec_open();
+    if (ret != PLATFORM_OK) {
+        return ret;
+    }
+
+    // 切換訊號源到 PS5 的實體位址，多數播放裝置收到後會自行開機
+    if (g_platform.ps5_phys != CEC_PHYS_ADDR_INVALID) {
+        const uint8_t stream_path[] = {
+            CEC_MSG_SET_STREAM_PATH, g_platform.ps5_phys >> 8, g_platform.ps5_phys & 0xff,
+        };
+        sent |= cec_send(CEC_LOG_ADDR_BROADCAST, stream_path, sizeof(stream_path));
+    }
+
+    const uint8_t power_on[] = { CEC_MSG_USER_CONTROL_PRESSED, CEC_OP_UI_CMD_POWER_ON_FUNCTION };
+    const uint8_t released[] = { CEC_MSG_USER_CONTROL_RELEASED };
+    if (cec_send(g_platform.ps5_la, power_on, sizeof(power_on))) {
+        cec_send(g_platform.ps5_la, released, sizeof(released));
+        sent = true;
+    }
+
+    g_platform.ps5_power_us = 0;  // 喚醒後立即重新查詢
+    if (!sent) {
+        set_error("PS5 wake not acknowledged on CEC bus");
+        return PLATFORM_ERROR;
+    }
     return PLATFORM_OK;
+#else
+    return PLATFORM_ERROR_NOT_FOUND;
+#endif
+}
+
+int platform_send_ps5_wake_span(uint32_t span_id) {
+#if PLATFORM_FEATURE_PS5
+    int ret = platform_send_ps5_wake();
+    if (ret == PLATFORM_OK) {
+        span_on_wake(span_id);
+    }
+    return ret;
+#else
+    (void)span_id;
+    return PLATFORM_ERROR_NOT_FOUND;
+#endif
 }
 
 const char* platform_get_last_error(void) {
-    return NULL;
+    if (g_platform.last_error[0] == '\0') {
+        return NULL;
+    }
+    return g_platform.last_error;
 }
 
 int platform_reset(void) {
-    // TODO: 硬體團隊實作
+#if PLATFORM_FEATURE_BUTTON
+    // 下次讀取時依目前配置重新取得按鈕線路
+    button_close();
+#endif
+    led_close();
+    mmio_close();
+    mmio_open();
+#if PLATFORM_FEATURE_PS5
+    cec_close();
+    cec_open();
+#endif
+    if (g_platform.led_custom) {
+        return platform_set_led_rgb(g_platform.led_rgb[0], g_platform.led_rgb[1],
+                                    g_platform.led_rgb[2]);
+    }
+    return platform_set_led_state(g_platform.led_state);
+}
+
+int platform_calibrate(void) {
+    platform_calibration_t c;
+    int measured = 0;
+
+    memset(&c, 0, sizeof(c));
+
+    if (probe_sysfs_write(&c.sysfs_write_us) == PLATFORM_OK) measured++;
+#if PLATFORM_FEATURE_BUTTON
+    if (probe_gpio_read(&c.gpio_read_us) == PLATFORM_OK) measured++;
+#endif
+#if PLATFORM_FEATURE_PS5
+    if (probe_cec(&c.cec_rtt_us, &c.ps5_response_us) == PLATFORM_OK) measured++;
+#endif
+
+    derive_policies(&c);
+    g_platform.calib = c;
+
+    printf("[Platform OpenWrt] Calibration: sysfs %uus, gpio %uus, "
+           "cec %uus, ps5 %uus\n",
+           c.sysfs_write_us, c.gpio_read_us, c.cec_rtt_us, c.ps5_response_us);
+
+    if (measured == 0) {
+        // 不保存，下次開機重試
+        set_error("Calibration failed: no hardware could be measured");
+        return PLATFORM_ERROR_NOT_FOUND;
+    }
+
+    save_calibration(&c);
+    return PLATFORM_OK;
+}
+
+int platform_get_calibration(platform_calibration_t *out) {
+    if (!out) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    if (g_platform.calib.cache_ttl_ms == 0) {
+        derive_policies(&g_platform.calib);  // 尚未初始化時提供預設策略
+    }
+    *out = g_platform.calib;
+    return PLATFORM_OK;
+}
+
+int platform_get_span_stats(platform_span_stats_t *out, int reset) {
+    if (!out) {
+        return PLATFORM_ERROR_PARAM;
+    }
+    memset(out, 0, sizeof(*out));
+
+    span_find(PLATFORM_SPAN_NONE, now_us());  // 先回收逾時的 span
+    for (int i = 0; i < SPAN_SLOTS; i++) {
+        if (g_spans.slots[i].id) {
+            out->open++;
+        }
+    }
+
+    for (int leg = 0; leg < PLATFORM_SPAN_LEG_COUNT; leg++) {
+        const span_hist_t *h = &g_spans.hist[leg];
+        out->legs[leg].count = h->count;
+        out->legs[leg].p50_us = span_percentile(h, 500);
+        out->legs[leg].p90_us = span_percentile(h, 900);
+        out->legs[leg].p99_us = span_percentile(h, 990);
+        out->legs[leg].max_us = h->max_us;
+    }
+    out->aborted = g_spans.aborted;
+    out->expired = g_spans.expired;
+
+    if (reset) {
+        memset(g_spans.hist, 0, sizeof(g_spans.hist));
+        g_spans.aborted = 0;
+        g_spans.expired = 0;
+    }
     return PLATFORM_OK;
 }
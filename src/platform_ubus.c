@@ -0,0 +1,817 @@
+/**
+ * @file platform_ubus.c
+ * @brief HAL 的 ubus 服務（gaming-platformd）
+ *
+ * 以 ubus 物件 gaming.platform 提供 HAL 的讀取與設定，並在狀態改變時送出通知。
+ * LuCI 頁面與健康檢查腳本訂閱一次即可，不必每隔幾秒 fork 一個 CLI
+ * 並執行完整的 platform_init()。
+ *
+ * 用法:
+ *   gaming-platformd [-s socket] [-b]
+ *
+ * - -s: ubusd socket 路徑（預設系統 socket，測試時可指向本地 ubusd）
+ * - -b: 成為按鈕擁有者並送出 button 通知（UCI daemon.buttons，見下方「按鈕線路」）
+ *
+ * 方法:
+ *   info             {}                      → {version, device_type}
+ *   get_led          {}                      → {state} 或 {r, g, b}（本服務最後設定的狀態）
+ *   set_led          {state[, span]} 或 {r, g, b}
+ *   clear_led_traffic {}                     → {state} 或 {r, g, b}（恢復 vpn_traffic 前的狀態）
+ *   get_buttons      {}                      → {mask, main}
+ *   get_ps5_power    {}                      → {power}
+ *   ps5_wake         {[span]}
+ *   get_calibration  {}                      → platform_calibration_t 各欄位
+ *   get_span_stats   {[reset]}               → {total, vpn, wake, ps5, open, aborted, expired}
+ *
+ * 通知（ubus subscribe gaming.platform）:
+ *   led     {state} 或 {r, g, b}             （只有經由本服務的 LED 變更）
+ *   button  {button, state, timestamp_ns, span}（僅 -b）
+ *   ps5     {power}                          （有訂閱者時才輪詢）
+ *
+ * LED 狀態:
+ *   platform_get_led() 是每個行程各自的記錄，get_led 與 led 通知只反映經由
+ *   本服務的 set_led / clear_led_traffic。其他行程（例如 gaming-client）
+ *   直接調用 platform_set_led() 的變更不會被讀到，也不會產生通知。
+ *
+ * 按鈕線路:
+ *   GPIO line request 是獨佔的，系統上只能有一個按鈕擁有者。
+ *   指定 -b 時 gaming-platformd 從啟動起持有線路並送出 button 通知，
+ *   其他行程應訂閱通知或呼叫 get_buttons，而不是直接讀取按鈕；
+ *   線路被其他行程持有時每秒重試一次。
+ *   未指定 -b 時不轉發按鈕事件，get_buttons 讀取後立即釋放線路，
+ *   訂閱 led / ps5 通知不會影響直接讀取按鈕的行程（例如 gaming-client）。
+ *
+ * 執行緒:
+ *   HAL 不保證執行緒安全，所有 HAL 調用集中在 HAL 執行緒。
+ *   主執行緒只跑 uloop / ubus：方法以 ubus_defer_request() 延後回覆，
+ *   工作交給 HAL 執行緒，完成後經 pipe 回到 uloop 送出回覆。
+ *   CEC 查詢（最長 ps5_reply_timeout_ms）不會卡住其他方法或通知。
+ *
+ * 本地測試:
+ *   ubusd -s /tmp/ubus.sock &
+ *   gaming-platformd -s /tmp/ubus.sock &
+ *   ubus -s /tmp/ubus.sock call gaming.platform set_led '{"state":"ps5_on"}'
+ *   ubus -s /tmp/ubus.sock subscribe gaming.platform
+ *
+ *   自動化測試見 tests/test_ubus.sh（make -C tests check-ubus）。
+ */
+
+#define _GNU_SOURCE  // pipe2()
+#include "platform_interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <libubox/uloop.h>
+#include <libubox/blobmsg.h>
+#include <libubus.h>
+
+#define UBUS_OBJECT_NAME "gaming.platform"
+#define BUTTON_RETRY_MS 1000  // 按鈕線路被其他行程持有時的重試間隔
+
+/* ============================================================================
+ * 狀態名稱
+ * ========================================================================== */
+
+static const char *const k_led_names[] = {
+    [LED_STATE_OFF]            = "off",
+    [LED_STATE_PS5_ON]         = "ps5_on",
+    [LED_STATE_PS5_STANDBY]    = "ps5_standby",
+    [LED_STATE_PS5_OFF]        = "ps5_off",
+    [LED_STATE_VPN_CONNECTING] = "vpn_connecting",
+    [LED_STATE_VPN_CONNECTED]  = "vpn_connected",
+    [LED_STATE_VPN_ERROR]      = "vpn_error",
+    [LED_STATE_QUERYING]       = "querying",
+    [LED_STATE_WAKING]         = "waking",
+    [LED_STATE_ERROR]          = "error",
+    [LED_STATE_SYSTEM_ERROR]   = "system_error",
+    [LED_STATE_SYSTEM_STARTUP] = "system_startup",
+    [LED_STATE_VPN_TRAFFIC]    = "vpn_traffic",
+};
+
+#define LED_STATE_COUNT ((int)(sizeof(k_led_names) / sizeof(k_led_names[0])))
+
+static const char *const k_power_names[] = {
+    [PLATFORM_PS5_UNKNOWN] = "unknown",
+    [PLATFORM_PS5_OFF]     = "off",
+    [PLATFORM_PS5_STANDBY] = "standby",
+    [PLATFORM_PS5_ON]      = "on",
+};
+
+/* ============================================================================
+ * 工作佇列（主執行緒 ↔ HAL 執行緒）
+ * ========================================================================== */
+
+typedef enum {
+    JOB_INFO,
+    JOB_GET_LED,
+    JOB_SET_LED,
+    JOB_CLEAR_LED_TRAFFIC,
+    JOB_GET_BUTTONS,
+    JOB_GET_PS5_POWER,
+    JOB_PS5_WAKE,
+    JOB_GET_CALIBRATION,
+    JOB_GET_SPAN_STATS,
+    JOB_NOTIFY_BUTTON,      // HAL 執行緒產生，主執行緒送出通知
+    JOB_NOTIFY_PS5,
+} job_type_t;
+
+typedef struct job {
+    struct job *next;
+    job_type_t type;
+    struct ubus_request_data req;   // 延後回覆的請求（通知類工作不使用）
+    int ret;                        // PLATFORM_* 返回碼
+    uint32_t span_id;               // set_led / ps5_wake 回報的延遲 span
+    bool reset;                     // get_span_stats 讀取後清除
+
+    // set_led 參數：led_state < 0 表示 RGB
+    int led_state;
+    uint8_t rgb[3];
+    platform_led_info_t led;        // LED 工作完成後的實際狀態
+
+    uint32_t mask;
+    platform_ps5_power_t power;
+    platform_button_event_t event;
+    platform_calibration_t calib;
+    platform_span_stats_t spans;
+    const char *version;
+    const char *device_type;
+} job_t;
+
+typedef struct {
+    job_t *head;
+    job_t *tail;
+} job_queue_t;
+
+static struct {
+    pthread_mutex_t lock;
+    job_queue_t pending;            // 主 → HAL
+    job_queue_t done;               // HAL → 主
+    int hal_wake[2];                // 喚醒 HAL 執行緒
+    int main_wake[2];               // 喚醒 uloop
+    atomic_bool running;
+    atomic_bool subscribed;         // 物件有訂閱者，HAL 執行緒才輪詢 PS5 電源
+    bool own_buttons;               // -b：持有按鈕線路並轉發事件（啟動後不變）
+
+    struct ubus_context *ctx;
+    struct uloop_fd done_fd;
+} g_daemon = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .hal_wake = { -1, -1 },
+    .main_wake = { -1, -1 },
+};
+
+static void queue_push(job_queue_t *q, job_t *job, int wake_fd) {
+    job->next = NULL;
+    pthread_mutex_lock(&g_daemon.lock);
+    if (q->tail) {
+        q->tail->next = job;
+    } else {
+        q->head = job;
+    }
+    q->tail = job;
+    pthread_mutex_unlock(&g_daemon.lock);
+
+    // pipe 滿時已有未處理的喚醒，忽略 EAGAIN
+    if (write(wake_fd, "", 1) < 0 && errno != EAGAIN) {
+        fprintf(stderr, "[gaming-platformd] wake: %s\n", strerror(errno));
+    }
+}
+
+static job_t *queue_pop(job_queue_t *q) {
+    pthread_mutex_lock(&g_daemon.lock);
+    job_t *job = q->head;
+    if (job) {
+        q->head = job->next;
+        if (!q->head) {
+            q->tail = NULL;
+        }
+    }
+    pthread_mutex_unlock(&g_daemon.lock);
+    return job;
+}
+
+static void drain(int fd) {
+    char buf[64];
+    while (read(fd, buf, sizeof(buf)) > 0) {
+    }
+}
+
+/* ============================================================================
+ * HAL 執行緒
+ * ========================================================================== */
+
+// 以下狀態只在 HAL 執行緒存取
+static struct {
+    platform_ps5_power_t power;     // 最後一次得知的 PS5 電源狀態
+    uint64_t next_power_poll_us;
+    bool buttons_busy;              // 按鈕線路被其他行程持有（只記錄一次）
+} g_hal = {
+    .power = PLATFORM_PS5_UNKNOWN,
+};
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief 記錄 PS5 電源狀態，改變時產生通知
+ */
+static void hal_note_power(platform_ps5_power_t power) {
+    if (power == g_hal.power) {
+        return;
+    }
+    g_hal.power = power;
+
+    job_t *job = calloc(1, sizeof(*job));
+    if (job) {
+        job->type = JOB_NOTIFY_PS5;
+        job->power = power;
+        queue_push(&g_daemon.done, job, g_daemon.main_wake[1]);
+    }
+}
+
+static void hal_execute(job_t *job) {
+    job->ret = PLATFORM_OK;
+
+    switch (job->type) {
+        case JOB_INFO:
+            job->version = platform_get_version();
+            job->device_type = platform_get_device_type();
+            break;
+
+        case JOB_GET_LED:
+            job->ret = platform_get_led(&job->led);
+            break;
+
+        case JOB_SET_LED:
+            if (job->led_state >= 0) {
+                job->ret = platform_set_led_state_span((platform_led_state_t)job->led_state,
+                                                       job->span_id);
+            } else {
+                job->ret = platform_set_led_rgb(job->rgb[0], job->rgb[1], job->rgb[2]);
+            }
+            platform_get_led(&job->led);
+            break;
+
+        case JOB_CLEAR_LED_TRAFFIC:
+            // 恢復的狀態由 HAL 決定，回覆與通知都以 HAL 的結果為準
+            job->ret = platform_clear_led_traffic();
+            platform_get_led(&job->led);
+            break;
+
+        case JOB_GET_BUTTONS:
+            job->ret = platform_get_buttons(&job->mask);
+            if (!g_daemon.own_buttons) {
+                platform_release_buttons();  // 不是按鈕擁有者時不佔用線路
+            }
+            break;
+
+        case JOB_GET_PS5_POWER:
+            job->power = platform_get_ps5_power();
+            hal_note_power(job->power);
+            break;
+
+        case JOB_PS5_WAKE:
+            job->ret = platform_send_ps5_wake_span(job->span_id);
+            g_hal.next_power_poll_us = 0;  // 喚醒後盡快重新查詢
+            break;
+
+        case JOB_GET_CALIBRATION:
+            job->ret = platform_get_calibration(&job->calib);
+            break;
+
+        case JOB_GET_SPAN_STATS:
+            job->ret = platform_get_span_stats(&job->spans, job->reset);
+            break;
+
+        default:
+            job->ret = PLATFORM_ERROR_PARAM;
+            break;
+    }
+
+    if (job->ret != PLATFORM_OK) {
+        fprintf(stderr, "[gaming-platformd] %s\n", platform_get_last_error());
+    }
+}
+
+static void hal_read_buttons(void) {
+    platform_button_event_t event;
+
+    while (platform_read_button_event(&event) == PLATFORM_OK) {
+        job_t *job = calloc(1, sizeof(*job));
+        if (!job) {
+            break;
+        }
+        job->type = JOB_NOTIFY_BUTTON;
+        job->event = event;
+        queue_push(&g_daemon.done, job, g_daemon.main_wake[1]);
+    }
+}
+
+/**
+ * @brief 有訂閱者時依 cache_ttl_ms 輪詢 PS5 電源
+ *
+ * @return 距離下次輪詢的毫秒數，-1 表示不需輪詢
+ */
+static int hal_poll_power(void) {
+#if PLATFORM_FEATURE_PS5
+    platform_calibration_t calib;
+
+    if (!atomic_load(&g_daemon.subscribed)) {
+        return -1;
+    }
+
+    uint64_t now = now_us();
+    if (now >= g_hal.next_power_poll_us) {
+        hal_note_power(platform_get_ps5_power());
+        platform_get_calibration(&calib);
+        g_hal.next_power_poll_us = now_us() + calib.cache_ttl_ms * 1000ull;
+        now = now_us();
+    }
+    return (int)((g_hal.next_power_poll_us - now) / 1000) + 1;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief 指定 -b 時持有按鈕線路並等待邊緣事件
+ *
+ * 按鈕線路是獨佔的（見 platform_get_buttons()），是否持有由 -b 明確指定，
+ * 不隨訂閱者改變，以免只訂閱 led / ps5 的頁面搶走 gaming-client 的按鈕。
+ *
+ * @return 按鈕事件 fd，-1 表示不等待按鈕
+ */
+static int hal_button_fd(void) {
+#if PLATFORM_FEATURE_BUTTON
+    if (!g_daemon.own_buttons) {
+        return -1;
+    }
+
+    int fd = platform_get_button_fd();
+    if (fd < 0 && !g_hal.buttons_busy) {
+        fprintf(stderr, "[gaming-platformd] %s, retrying\n", platform_get_last_error());
+    } else if (fd >= 0 && g_hal.buttons_busy) {
+        fprintf(stderr, "[gaming-platformd] Button lines acquired\n");
+    }
+    g_hal.buttons_busy = fd < 0;
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief 合併 PS5 輪詢與按鈕線路重試的 poll 逾時
+ */
+static int hal_poll_timeout(int button_fd) {
+    int timeout = hal_poll_power();
+
+    if (PLATFORM_FEATURE_BUTTON && g_daemon.own_buttons && button_fd < 0 &&
+        (timeout < 0 || timeout > BUTTON_RETRY_MS)) {
+        timeout = BUTTON_RETRY_MS;
+    }
+    return timeout;
+}
+
+static void *hal_thread(void *arg) {
+    (void)arg;
+
+    while (atomic_load(&g_daemon.running)) {
+        struct pollfd pfd[2] = {
+            { .fd = g_daemon.hal_wake[0], .events = POLLIN },
+            { .fd = hal_button_fd(), .events = POLLIN },
+        };
+        int nfds = pfd[1].fd >= 0 ? 2 : 1;
+
+        if (poll(pfd, nfds, hal_poll_timeout(pfd[1].fd)) < 0 && errno != EINTR) {
+            fprintf(stderr, "[gaming-platformd] poll: %s\n", strerror(errno));
+            break;
+        }
+
+        if (pfd[0].revents & POLLIN) {
+            drain(g_daemon.hal_wake[0]);
+        }
+
+        job_t *job;
+        while ((job = queue_pop(&g_daemon.pending))) {
+            hal_execute(job);
+            queue_push(&g_daemon.done, job, g_daemon.main_wake[1]);
+        }
+
+        if (nfds == 2 && (pfd[1].revents & POLLIN)) {
+            hal_read_buttons();
+        }
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * ubus（主執行緒）
+ * ========================================================================== */
+
+static struct blob_buf g_buf;
+static struct ubus_object g_object;
+
+static int ubus_status(int ret) {
+    switch (ret) {
+        case PLATFORM_OK:              return UBUS_STATUS_OK;
+        case PLATFORM_ERROR_PARAM:     return UBUS_STATUS_INVALID_ARGUMENT;
+        case PLATFORM_ERROR_TIMEOUT:   return UBUS_STATUS_TIMEOUT;
+        case PLATFORM_ERROR_NOT_FOUND: return UBUS_STATUS_NOT_FOUND;
+        default:                       return UBUS_STATUS_UNKNOWN_ERROR;
+    }
+}
+
+static void add_led(const platform_led_info_t *led) {
+    if (!led->custom && (unsigned int)led->state < LED_STATE_COUNT &&
+        k_led_names[led->state]) {
+        blobmsg_add_string(&g_buf, "state", k_led_names[led->state]);
+    } else {
+        blobmsg_add_u32(&g_buf, "r", led->r);
+        blobmsg_add_u32(&g_buf, "g", led->g);
+        blobmsg_add_u32(&g_buf, "b", led->b);
+    }
+}
+
+static void add_span_stats(const platform_span_stats_t *st) {
+    static const char *const legs[PLATFORM_SPAN_LEG_COUNT] = {
+        [PLATFORM_SPAN_TOTAL] = "total",
+        [PLATFORM_SPAN_VPN]   = "vpn",
+        [PLATFORM_SPAN_WAKE]  = "wake",
+        [PLATFORM_SPAN_PS5]   = "ps5",
+    };
+
+    for (int i = 0; i < PLATFORM_SPAN_LEG_COUNT; i++) {
+        void *t = blobmsg_open_table(&g_buf, legs[i]);
+        blobmsg_add_u32(&g_buf, "count", st->legs[i].count);
+        blobmsg_add_u32(&g_buf, "p50_us", st->legs[i].p50_us);
+        blobmsg_add_u32(&g_buf, "p90_us", st->legs[i].p90_us);
+        blobmsg_add_u32(&g_buf, "p99_us", st->legs[i].p99_us);
+        blobmsg_add_u32(&g_buf, "max_us", st->legs[i].max_us);
+        blobmsg_close_table(&g_buf, t);
+    }
+    blobmsg_add_u32(&g_buf, "open", st->open);
+    blobmsg_add_u32(&g_buf, "aborted", st->aborted);
+    blobmsg_add_u32(&g_buf, "expired", st->expired);
+}
+
+/**
+ * @brief 把完成的工作轉成回覆或通知
+ */
+static void job_complete(job_t *job) {
+    const char *notify = NULL;
+
+    blob_buf_init(&g_buf, 0);
+
+    switch (job->type) {
+        case JOB_INFO:
+            blobmsg_add_string(&g_buf, "version", job->version);
+            blobmsg_add_string(&g_buf, "device_type", job->device_type);
+            break;
+
+        case JOB_GET_LED:
+            add_led(&job->led);
+            break;
+
+        case JOB_SET_LED:
+        case JOB_CLEAR_LED_TRAFFIC:
+            if (job->ret == PLATFORM_OK) {
+                add_led(&job->led);
+                notify = "led";
+            }
+            break;
+
+        case JOB_GET_BUTTONS:
+            blobmsg_add_u32(&g_buf, "mask", job->mask);
+            blobmsg_add_u8(&g_buf, "main", (job->mask >> PLATFORM_BUTTON_MAIN) & 1u);
+            break;
+
+        case JOB_GET_PS5_POWER:
+            blobmsg_add_string(&g_buf, "power", k_power_names[job->power]);
+            break;
+
+        case JOB_PS5_WAKE:
+            break;
+
+        case JOB_GET_CALIBRATION:
+            blobmsg_add_u32(&g_buf, "sysfs_write_us", job->calib.sysfs_write_us);
+            blobmsg_add_u32(&g_buf, "gpio_read_us", job->calib.gpio_read_us);
+            blobmsg_add_u32(&g_buf, "cec_rtt_us", job->calib.cec_rtt_us);
+            blobmsg_add_u32(&g_buf, "ps5_response_us", job->calib.ps5_response_us);
+            blobmsg_add_u32(&g_buf, "cache_ttl_ms", job->calib.cache_ttl_ms);
+            blobmsg_add_u32(&g_buf, "poll_min_ms", job->calib.poll_min_ms);
+            blobmsg_add_u32(&g_buf, "poll_max_ms", job->calib.poll_max_ms);
+            blobmsg_add_u32(&g_buf, "cec_timeout_ms", job->calib.cec_timeout_ms);
+            blobmsg_add_u32(&g_buf, "ps5_reply_timeout_ms", job->calib.ps5_reply_timeout_ms);
+            break;
+
+        case JOB_GET_SPAN_STATS:
+            add_span_stats(&job->spans);
+            break;
+
+        case JOB_NOTIFY_BUTTON:
+            blobmsg_add_u32(&g_buf, "button", job->event.button);
+            blobmsg_add_string(&g_buf, "state",
+                               job->event.state == BUTTON_PRESSED ? "pressed" : "released");
+            blobmsg_add_u64(&g_buf, "timestamp_ns", job->event.timestamp_ns);
+            blobmsg_add_u32(&g_buf, "span", job->event.span_id);
+            notify = "button";
+            break;
+
+        case JOB_NOTIFY_PS5:
+            blobmsg_add_string(&g_buf, "power", k_power_names[job->power]);
+            notify = "ps5";
+            break;
+    }
+
+    if (job->type != JOB_NOTIFY_BUTTON && job->type != JOB_NOTIFY_PS5) {
+        if (job->ret == PLATFORM_OK) {
+            ubus_send_reply(g_daemon.ctx, &job->req, g_buf.head);
+        }
+        ubus_complete_deferred_request(g_daemon.ctx, &job->req, ubus_status(job->ret));
+    }
+
+    if (notify && g_object.has_subscribers) {
+        ubus_notify(g_daemon.ctx, &g_object, notify, g_buf.head, -1);
+    }
+}
+
+static void done_cb(struct uloop_fd *fd, unsigned int events) {
+    (void)events;
+    job_t *job;
+
+    drain(fd->fd);
+    while ((job = queue_pop(&g_daemon.done))) {
+        job_complete(job);
+        free(job);
+    }
+}
+
+/**
+ * @brief 延後回覆並把工作交給 HAL 執行緒
+ */
+static int submit(struct ubus_context *ctx, struct ubus_request_data *req,
+                  job_type_t type, const job_t *args) {
+    job_t *job = calloc(1, sizeof(*job));
+    if (!job) {
+        return UBUS_STATUS_UNKNOWN_ERROR;
+    }
+    if (args) {
+        *job = *args;
+    }
+    job->type = type;
+
+    ubus_defer_request(ctx, req, &job->req);
+    queue_push(&g_daemon.pending, job, g_daemon.hal_wake[1]);
+    return UBUS_STATUS_OK;
+}
+
+#define DEFINE_SIMPLE_METHOD(fn, type)                                              \
+    static int fn(struct ubus_context *ctx, struct ubus_object *obj,                \
+                  struct ubus_request_data *req, const char *method,                \
+                  struct blob_attr *msg) {                                          \
+        (void)obj; (void)method; (void)msg;                                         \
+        return submit(ctx, req, type, NULL);                                        \
+    }
+
+DEFINE_SIMPLE_METHOD(method_info, JOB_INFO)
+DEFINE_SIMPLE_METHOD(method_get_led, JOB_GET_LED)
+DEFINE_SIMPLE_METHOD(method_clear_led_traffic, JOB_CLEAR_LED_TRAFFIC)
+DEFINE_SIMPLE_METHOD(method_get_calibration, JOB_GET_CALIBRATION)
+#if PLATFORM_FEATURE_BUTTON
+DEFINE_SIMPLE_METHOD(method_get_buttons, JOB_GET_BUTTONS)
+#endif
+#if PLATFORM_FEATURE_PS5
+DEFINE_SIMPLE_METHOD(method_get_ps5_power, JOB_GET_PS5_POWER)
+#endif
+
+enum {
+    SET_LED_STATE,
+    SET_LED_R,
+    SET_LED_G,
+    SET_LED_B,
+    SET_LED_SPAN,
+    __SET_LED_MAX,
+};
+
+static const struct blobmsg_policy set_led_policy[__SET_LED_MAX] = {
+    [SET_LED_STATE] = { .name = "state", .type = BLOBMSG_TYPE_STRING },
+    [SET_LED_R]     = { .name = "r", .type = BLOBMSG_TYPE_INT32 },
+    [SET_LED_G]     = { .name = "g", .type = BLOBMSG_TYPE_INT32 },
+    [SET_LED_B]     = { .name = "b", .type = BLOBMSG_TYPE_INT32 },
+    [SET_LED_SPAN]  = { .name = "span", .type = BLOBMSG_TYPE_INT32 },
+};
+
+static int method_set_led(struct ubus_context *ctx, struct ubus_object *obj,
+                          struct ubus_request_data *req, const char *method,
+                          struct blob_attr *msg) {
+    struct blob_attr *tb[__SET_LED_MAX];
+    job_t args = { .led_state = -1 };
+    (void)obj;
+    (void)method;
+
+    blobmsg_parse(set_led_policy, __SET_LED_MAX, tb, blob_data(msg), blob_len(msg));
+
+    if (tb[SET_LED_SPAN]) {
+        args.span_id = blobmsg_get_u32(tb[SET_LED_SPAN]);
+    }
+
+    if (tb[SET_LED_STATE]) {
+        const char *name = blobmsg_get_string(tb[SET_LED_STATE]);
+        for (int i = 0; i < LED_STATE_COUNT; i++) {
+            if (k_led_names[i] && strcmp(name, k_led_names[i]) == 0) {
+                args.led_state = i;
+                break;
+            }
+        }
+        if (args.led_state < 0) {
+            return UBUS_STATUS_INVALID_ARGUMENT;
+        }
+    } else if (tb[SET_LED_R] && tb[SET_LED_G] && tb[SET_LED_B]) {
+        for (int i = 0; i < 3; i++) {
+            uint32_t v = blobmsg_get_u32(tb[SET_LED_R + i]);
+            if (v > 255) {
+                return UBUS_STATUS_INVALID_ARGUMENT;
+            }
+            args.rgb[i] = (uint8_t)v;
+        }
+    } else {
+        return UBUS_STATUS_INVALID_ARGUMENT;
+    }
+
+    return submit(ctx, req, JOB_SET_LED, &args);
+}
+
+#if PLATFORM_FEATURE_PS5
+enum {
+    PS5_WAKE_SPAN,
+    __PS5_WAKE_MAX,
+};
+
+static const struct blobmsg_policy ps5_wake_policy[__PS5_WAKE_MAX] = {
+    [PS5_WAKE_SPAN] = { .name = "span", .type = BLOBMSG_TYPE_INT32 },
+};
+
+static int method_ps5_wake(struct ubus_context *ctx, struct ubus_object *obj,
+                           struct ubus_request_data *req, const char *method,
+                           struct blob_attr *msg) {
+    struct blob_attr *tb[__PS5_WAKE_MAX];
+    job_t args = { .span_id = PLATFORM_SPAN_NONE };
+    (void)obj;
+    (void)method;
+
+    blobmsg_parse(ps5_wake_policy, __PS5_WAKE_MAX, tb, blob_data(msg), blob_len(msg));
+    if (tb[PS5_WAKE_SPAN]) {
+        args.span_id = blobmsg_get_u32(tb[PS5_WAKE_SPAN]);
+    }
+    return submit(ctx, req, JOB_PS5_WAKE, &args);
+}
+#endif
+
+enum {
+    SPAN_STATS_RESET,
+    __SPAN_STATS_MAX,
+};
+
+static const struct blobmsg_policy span_stats_policy[__SPAN_STATS_MAX] = {
+    [SPAN_STATS_RESET] = { .name = "reset", .type = BLOBMSG_TYPE_BOOL },
+};
+
+static int method_get_span_stats(struct ubus_context *ctx, struct ubus_object *obj,
+                                 struct ubus_request_data *req, const char *method,
+                                 struct blob_attr *msg) {
+    struct blob_attr *tb[__SPAN_STATS_MAX];
+    job_t args = { .reset = false };
+    (void)obj;
+    (void)method;
+
+    blobmsg_parse(span_stats_policy, __SPAN_STATS_MAX, tb, blob_data(msg), blob_len(msg));
+    if (tb[SPAN_STATS_RESET]) {
+        args.reset = blobmsg_get_bool(tb[SPAN_STATS_RESET]);
+    }
+    return submit(ctx, req, JOB_GET_SPAN_STATS, &args);
+}
+
+static const struct ubus_method g_methods[] = {
+    UBUS_METHOD_NOARG("info", method_info),
+    UBUS_METHOD_NOARG("get_led", method_get_led),
+    UBUS_METHOD("set_led", method_set_led, set_led_policy),
+    UBUS_METHOD_NOARG("clear_led_traffic", method_clear_led_traffic),
+#if PLATFORM_FEATURE_BUTTON
+    UBUS_METHOD_NOARG("get_buttons", method_get_buttons),
+#endif
+#if PLATFORM_FEATURE_PS5
+    UBUS_METHOD_NOARG("get_ps5_power", method_get_ps5_power),
+    UBUS_METHOD("ps5_wake", method_ps5_wake, ps5_wake_policy),
+#endif
+    UBUS_METHOD_NOARG("get_calibration", method_get_calibration),
+    UBUS_METHOD("get_span_stats", method_get_span_stats, span_stats_policy),
+};
+
+static struct ubus_object_type g_object_type =
+    UBUS_OBJECT_TYPE(UBUS_OBJECT_NAME, g_methods);
+
+static void subscribe_cb(struct ubus_context *ctx, struct ubus_object *obj) {
+    (void)ctx;
+    atomic_store(&g_daemon.subscribed, obj->has_subscribers);
+    if (write(g_daemon.hal_wake[1], "", 1) < 0 && errno != EAGAIN) {
+        fprintf(stderr, "[gaming-platformd] wake: %s\n", strerror(errno));
+    }
+}
+
+static struct ubus_object g_object = {
+    .name = UBUS_OBJECT_NAME,
+    .type = &g_object_type,
+    .methods = g_methods,
+    .n_methods = ARRAY_SIZE(g_methods),
+    .subscribe_cb = subscribe_cb,
+};
+
+/* ============================================================================
+ * main
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+    const char *socket_path = NULL;
+    pthread_t thread;
+    int opt;
+    int ret = 1;
+
+    while ((opt = getopt(argc, argv, "s:b")) != -1) {
+        switch (opt) {
+            case 's': socket_path = optarg; break;
+            case 'b': g_daemon.own_buttons = true; break;
+            default:
+                fprintf(stderr, "Usage: %s [-s socket] [-b]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (pipe2(g_daemon.hal_wake, O_NONBLOCK | O_CLOEXEC) < 0 ||
+        pipe2(g_daemon.main_wake, O_NONBLOCK | O_CLOEXEC) < 0) {
+        fprintf(stderr, "[gaming-platformd] pipe: %s\n", strerror(errno));
+        return 1;
+    }
+
+    if (platform_init() != PLATFORM_OK) {
+        fprintf(stderr, "[gaming-platformd] platform_init: %s\n", platform_get_last_error());
+        return 1;
+    }
+
+    uloop_init();
+
+    g_daemon.ctx = ubus_connect(socket_path);
+    if (!g_daemon.ctx) {
+        fprintf(stderr, "[gaming-platformd] Cannot connect to ubus\n");
+        goto out_platform;
+    }
+    ubus_add_uloop(g_daemon.ctx);
+
+    if (ubus_add_object(g_daemon.ctx, &g_object) != 0) {
+        fprintf(stderr, "[gaming-platformd] Cannot register " UBUS_OBJECT_NAME "\n");
+        goto out_ubus;
+    }
+
+    g_daemon.done_fd.fd = g_daemon.main_wake[0];
+    g_daemon.done_fd.cb = done_cb;
+    uloop_fd_add(&g_daemon.done_fd, ULOOP_READ);
+
+    atomic_store(&g_daemon.running, true);
+    if (pthread_create(&thread, NULL, hal_thread, NULL) != 0) {
+        fprintf(stderr, "[gaming-platformd] Cannot start HAL thread\n");
+        goto out_ubus;
+    }
+
+    printf("[gaming-platformd] " UBUS_OBJECT_NAME " ready\n");
+    uloop_run();
+    ret = 0;
+
+    atomic_store(&g_daemon.running, false);
+    if (write(g_daemon.hal_wake[1], "", 1) < 0 && errno != EAGAIN) {
+        fprintf(stderr, "[gaming-platformd] wake: %s\n", strerror(errno));
+    }
+    pthread_join(thread, NULL);
+
+    // 結束時未回覆的請求由 ubusd 視為逾時
+    job_t *job;
+    while ((job = queue_pop(&g_daemon.pending)) || (job = queue_pop(&g_daemon.done))) {
+        free(job);
+    }
+
+out_ubus:
+    ubus_free(g_daemon.ctx);
+out_platform:
+    uloop_done();
+    platform_cleanup();
+    return ret;
+}
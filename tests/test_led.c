@@ -0,0 +1,134 @@
+/**
+ * @file test_led.c
+ * @brief LED 狀態與 VPN 流量指示的主機端測試
+ *
+ * LED 目錄指向一般檔案組成的假 sysfs，檢查寫入的 trigger 與 platform_get_led()：
+ *   - 流量指示中設定閃爍狀態會結束流量指示，之後的 clear 不做任何事
+ *   - 流量指示中設定顏色同樣結束流量指示
+ *   - clear 恢復進入前的狀態或自定義顏色
+ *   - 欄位越界或字串沒有結尾的 blob 被拒絕，改用預設值（tests/Makefile 指向同一組 LED）
+ */
+
+#include "test_util.h"
+
+/* ============================================================================
+ * 測試案例
+ * ========================================================================== */
+
+/** CONNECTED → TRAFFIC → CONNECTING → clear：維持藍色閃爍 */
+static void test_blink_ends_traffic(void) {
+    platform_led_info_t led;
+    char buf[32];
+
+    platform_set_led_state(LED_STATE_VPN_CONNECTED);
+    platform_set_led_state(LED_STATE_VPN_TRAFFIC);
+    read_led(1, "trigger", buf, sizeof(buf));
+    CHECK(strcmp(buf, "netdev") == 0, "green trigger \"%s\", expected netdev", buf);
+
+    platform_set_led_state(LED_STATE_VPN_CONNECTING);
+    reset_leds();
+    CHECK(platform_clear_led_traffic() == PLATFORM_OK, "clear_led_traffic");
+    read_led(2, "trigger", buf, sizeof(buf));
+    CHECK(buf[0] == '\0', "clear rewrote blue trigger: \"%s\"", buf);
+    read_led(1, "brightness", buf, sizeof(buf));
+    CHECK(buf[0] == '\0', "clear rewrote green brightness: \"%s\"", buf);
+
+    CHECK(platform_get_led(&led) == PLATFORM_OK, "get_led");
+    CHECK(led.state == LED_STATE_VPN_CONNECTING && !led.custom,
+          "state %d custom %d, expected VPN_CONNECTING", led.state, led.custom);
+    CHECK(led.r == 0 && led.g == 0 && led.b == 255, "rgb %u,%u,%u", led.r, led.g, led.b);
+}
+
+/** 自定義顏色 → TRAFFIC → clear：恢復自定義顏色 */
+static void test_clear_restores_custom(void) {
+    platform_led_info_t led;
+    char buf[32];
+
+    platform_set_led_rgb(0, 0, 255);
+    platform_set_led_state(LED_STATE_VPN_TRAFFIC);
+    CHECK(platform_get_led(&led) == PLATFORM_OK && led.state == LED_STATE_VPN_TRAFFIC &&
+          !led.custom && led.b == 255, "traffic: state %d custom %d b %u",
+          led.state, led.custom, led.b);
+
+    reset_leds();
+    CHECK(platform_clear_led_traffic() == PLATFORM_OK, "clear_led_traffic");
+    read_led(2, "brightness", buf, sizeof(buf));
+    CHECK(strcmp(buf, "255") == 0, "blue brightness \"%s\", expected 255", buf);
+    CHECK(platform_get_led(&led) == PLATFORM_OK && led.custom &&
+          led.r == 0 && led.g == 0 && led.b == 255,
+          "custom %d rgb %u,%u,%u", led.custom, led.r, led.g, led.b);
+}
+
+/** TRAFFIC 中設定顏色：結束流量指示，之後的 clear 不改變顏色 */
+static void test_rgb_ends_traffic(void) {
+    platform_led_info_t led;
+    char buf[32];
+
+    platform_set_led_state(LED_STATE_PS5_ON);
+    platform_set_led_state(LED_STATE_VPN_TRAFFIC);
+    platform_set_led_rgb(255, 0, 0);
+
+    reset_leds();
+    CHECK(platform_clear_led_traffic() == PLATFORM_OK, "clear_led_traffic");
+    read_led(0, "brightness", buf, sizeof(buf));
+    CHECK(buf[0] == '\0', "clear rewrote red brightness: \"%s\"", buf);
+    CHECK(platform_get_led(&led) == PLATFORM_OK && led.custom &&
+          led.r == 255 && led.g == 0 && led.b == 0,
+          "custom %d rgb %u,%u,%u", led.custom, led.r, led.g, led.b);
+}
+
+/**
+ * @brief CRC 正確但內容無效的 blob：被拒絕時使用預設 LED 路徑（TEST_DIR/leds），
+ *        被接受時會寫到不存在的 leds-blob 目錄而失敗
+ */
+static void test_invalid_blob_rejected(void) {
+    static const char *const cases[] = {
+        "button_count", "ps5_cec_addr", "led_red", "vpn_interface", "gpio_mmio_path",
+    };
+    platform_config_t cfg;
+    char buf[32];
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        test_config_defaults(&cfg);
+        snprintf(cfg.led_red, sizeof(cfg.led_red), TEST_DIR "/leds-blob/red");
+        snprintf(cfg.led_green, sizeof(cfg.led_green), TEST_DIR "/leds-blob/green");
+        snprintf(cfg.led_blue, sizeof(cfg.led_blue), TEST_DIR "/leds-blob/blue");
+        switch (i) {
+            case 0: cfg.button_count = PLATFORM_CONFIG_MAX_BUTTONS + 1; break;
+            case 1: cfg.ps5_cec_addr = 15; break;
+            case 2: memset(cfg.led_red, 'a', sizeof(cfg.led_red)); break;
+            case 3: memset(cfg.vpn_interface, 'a', sizeof(cfg.vpn_interface)); break;
+            case 4: memset(cfg.gpio_mmio_path, 'a', sizeof(cfg.gpio_mmio_path)); break;
+        }
+        test_write_config(&cfg);
+        reset_leds();
+
+        CHECK(platform_init() == PLATFORM_OK, "%s: init: %s", cases[i], platform_get_last_error());
+        CHECK(platform_set_led_rgb(255, 0, 0) == PLATFORM_OK, "%s: blob accepted (%s)",
+              cases[i], platform_get_last_error());
+        read_led(0, "brightness", buf, sizeof(buf));
+        CHECK(strcmp(buf, "255") == 0, "%s: red brightness \"%s\", expected 255", cases[i], buf);
+        platform_cleanup();
+    }
+}
+
+int main(void) {
+    platform_config_t cfg;
+
+    reset_leds();
+    test_config_defaults(&cfg);
+    test_write_config(&cfg);
+    if (platform_init() != PLATFORM_OK) {
+        fprintf(stderr, "init: %s\n", platform_get_last_error());
+        return 1;
+    }
+
+    test_blink_ends_traffic();
+    test_clear_restores_custom();
+    test_rgb_ends_traffic();
+    platform_cleanup();
+
+    test_invalid_blob_rejected();
+
+    return test_report("test_led");
+}
@@ -0,0 +1,185 @@
+/**
+ * @file test_mmio.c
+ * @brief GPIO 暫存器映像模式的主機端測試
+ *
+ * gpio_mmio_path 指向一般檔案時，HAL 把它當作暫存器區塊映射（MAP_SHARED），
+ * 測試直接讀寫同一檔案來模擬輸入腳位並檢查 LED 輸出：
+ *   - SET/CLR 暫存器：按鈕遮罩、主按鈕狀態、LED 寫入
+ *   - 只有 DOUT：讀-改-寫保留其他腳位，LED 低電位點亮
+ *   - 自我檢查失敗：停用暫存器，按鈕退回 chardev、LED 退回 sysfs
+ */
+
+#include "test_util.h"
+
+#define IMAGE_PATH  TEST_DIR "/gpio-regs.img"
+#define IMAGE_SIZE  4096
+#define REG_DOUT    0x100
+#define REG_SET     0x104
+#define REG_CLR     0x108
+#define REG_DIN     0x200
+
+/* ============================================================================
+ * 測試環境
+ * ========================================================================== */
+
+/**
+ * @brief 寫入測試配置：按鈕 0/1 在 DIN 位元 0/3（低電位按下），LED R/G/B 在 DOUT 位元 1/2/3
+ */
+static void write_config(uint32_t din_reg, uint32_t set_reg, uint32_t clr_reg,
+                         uint32_t led_active_low) {
+    platform_config_t cfg;
+
+    test_config_defaults(&cfg);
+    snprintf(cfg.gpio_mmio_path, sizeof(cfg.gpio_mmio_path), IMAGE_PATH);
+
+    cfg.button_count = 2;
+    cfg.button_lines[1] = 1;
+    cfg.button_active_low = 1;
+    cfg.gpio_mmio_offset = 0;
+    cfg.gpio_mmio_size = IMAGE_SIZE;
+    cfg.mmio_din_reg = din_reg;
+    cfg.mmio_dout_reg = REG_DOUT;
+    cfg.mmio_dout_set_reg = set_reg;
+    cfg.mmio_dout_clr_reg = clr_reg;
+    cfg.mmio_button_bits[0] = 0;
+    cfg.mmio_button_bits[1] = 3;
+    cfg.mmio_led_bits[0] = 1;
+    cfg.mmio_led_bits[1] = 2;
+    cfg.mmio_led_bits[2] = 3;
+    cfg.mmio_led_active_low = led_active_low;
+
+    test_write_config(&cfg);
+}
+
+static void write_image(uint32_t din, uint32_t dout) {
+    static uint32_t regs[IMAGE_SIZE / 4];
+
+    memset(regs, 0, sizeof(regs));
+    regs[REG_DIN / 4] = din;
+    regs[REG_DOUT / 4] = dout;
+    write_file(IMAGE_PATH, regs, sizeof(regs));
+}
+
+static void write_reg(uint32_t offset, uint32_t value) {
+    int fd = open(IMAGE_PATH, O_WRONLY);
+    if (fd < 0 || pwrite(fd, &value, sizeof(value), offset) != sizeof(value)) {
+        fprintf(stderr, "Cannot write register 0x%x\n", offset);
+        exit(2);
+    }
+    close(fd);
+}
+
+static uint32_t read_reg(uint32_t offset) {
+    uint32_t value = 0;
+    int fd = open(IMAGE_PATH, O_RDONLY);
+    if (fd < 0 || pread(fd, &value, sizeof(value), offset) != sizeof(value)) {
+        fprintf(stderr, "Cannot read register 0x%x\n", offset);
+        exit(2);
+    }
+    close(fd);
+    return value;
+}
+
+/* ============================================================================
+ * 測試案例
+ * ========================================================================== */
+
+/** SET/CLR 暫存器：按鈕直接從 DIN 取樣，LED 寫入不經過 sysfs */
+static void test_set_clr(void) {
+    uint32_t mask = 0;
+    char buf[16];
+
+    reset_leds();
+    write_config(REG_DIN, REG_SET, REG_CLR, 0);
+    write_image(~(1u << 3), 0);  // 按鈕 1 按下（位元 3 低電位）
+    CHECK(platform_init() == PLATFORM_OK, "init: %s", platform_get_last_error());
+
+#if PLATFORM_FEATURE_BUTTON
+    CHECK(platform_get_buttons(&mask) == PLATFORM_OK, "get_buttons: %s",
+          platform_get_last_error());
+    CHECK(mask == 0x2, "mask 0x%x, expected 0x2", mask);
+    CHECK(platform_get_button_state() == BUTTON_RELEASED, "main button should be released");
+
+    // 映射為 MAP_SHARED，檔案內容變更立即反映在下一次讀取
+    write_reg(REG_DIN, ~(1u << 0));
+    CHECK(platform_get_buttons(&mask) == PLATFORM_OK && mask == 0x1,
+          "mask 0x%x after DIN change, expected 0x1", mask);
+    CHECK(platform_get_button_state() == BUTTON_PRESSED, "main button should be pressed");
+#else
+    (void)mask;
+#endif
+
+    write_reg(REG_SET, 0);
+    write_reg(REG_CLR, 0);
+    CHECK(platform_set_led_rgb(255, 0, 255) == PLATFORM_OK, "set_led_rgb: %s",
+          platform_get_last_error());
+    CHECK(read_reg(REG_SET) == ((1u << 1) | (1u << 3)), "SET 0x%x", read_reg(REG_SET));
+    CHECK(read_reg(REG_CLR) == (1u << 2), "CLR 0x%x", read_reg(REG_CLR));
+
+    CHECK(platform_set_led_state(LED_STATE_VPN_CONNECTED) == PLATFORM_OK, "set_led_state");
+    CHECK(read_reg(REG_SET) == (1u << 2), "SET 0x%x", read_reg(REG_SET));
+    CHECK(read_reg(REG_CLR) == ((1u << 1) | (1u << 3)), "CLR 0x%x", read_reg(REG_CLR));
+
+    for (int i = 0; i < 3; i++) {
+        read_led(i, "brightness", buf, sizeof(buf));
+        CHECK(buf[0] == '\0', "%s brightness written via sysfs: \"%s\"", k_led_names[i], buf);
+    }
+    platform_cleanup();
+}
+
+/** 只有 DOUT：讀-改-寫只改 LED 位元，低電位點亮 */
+static void test_dout_rmw(void) {
+    reset_leds();
+    write_config(REG_DIN, PLATFORM_CONFIG_NO_REG, PLATFORM_CONFIG_NO_REG, 1);
+    write_image(~0u, 0xF0000001u);  // 其他腳位的輸出必須保留
+    CHECK(platform_init() == PLATFORM_OK, "init: %s", platform_get_last_error());
+
+    CHECK(platform_set_led_rgb(255, 0, 0) == PLATFORM_OK, "set_led_rgb: %s",
+          platform_get_last_error());
+    uint32_t dout = read_reg(REG_DOUT);
+    CHECK(dout == (0xF0000001u | (1u << 2) | (1u << 3)), "DOUT 0x%x", dout);
+
+    CHECK(platform_set_led_rgb(0, 0, 0) == PLATFORM_OK, "set_led_rgb off");
+    dout = read_reg(REG_DOUT);
+    CHECK(dout == (0xF0000001u | (1u << 1) | (1u << 2) | (1u << 3)), "DOUT 0x%x", dout);
+    platform_cleanup();
+}
+
+/** 自我檢查失敗（DIN 偏移超出映射）：暫存器不再被寫入，改走 chardev/sysfs */
+static void test_self_check_fallback(void) {
+    uint32_t mask = 0;
+    char buf[16];
+
+    reset_leds();
+    write_config(IMAGE_SIZE, REG_SET, REG_CLR, 0);
+    write_image(~(1u << 3), 0);
+    CHECK(platform_init() == PLATFORM_OK, "init: %s", platform_get_last_error());
+
+#if PLATFORM_FEATURE_BUTTON
+    // 測試環境沒有 GPIO chip，退回 chardev 後讀取失敗，而不是讀到映像內容
+    CHECK(platform_get_buttons(&mask) != PLATFORM_OK, "buttons read from registers (0x%x)", mask);
+    CHECK(platform_get_button_state() == BUTTON_UNAVAILABLE,
+          "read failure reported as %d, expected BUTTON_UNAVAILABLE", platform_get_button_state());
+#else
+    (void)mask;
+#endif
+
+    CHECK(platform_set_led_rgb(255, 0, 0) == PLATFORM_OK, "set_led_rgb: %s",
+          platform_get_last_error());
+    CHECK(read_reg(REG_SET) == 0 && read_reg(REG_CLR) == 0,
+          "registers written after failed self-check (SET 0x%x CLR 0x%x)",
+          read_reg(REG_SET), read_reg(REG_CLR));
+    read_led(0, "brightness", buf, sizeof(buf));
+    CHECK(strcmp(buf, "255") == 0, "red brightness \"%s\", expected \"255\"", buf);
+    read_led(1, "brightness", buf, sizeof(buf));
+    CHECK(strcmp(buf, "0") == 0, "green brightness \"%s\", expected \"0\"", buf);
+    platform_cleanup();
+}
+
+int main(void) {
+    test_set_clr();
+    test_dout_rmw();
+    test_self_check_fallback();
+
+    return test_report("test_mmio");
+}
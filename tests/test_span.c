@@ -0,0 +1,125 @@
+/**
+ * @file test_span.c
+ * @brief 延遲 span 直方圖與回收的主機端測試
+ *
+ * 直接引入 platform_openwrt.c 以存取內部函式，不需要 platform_init()：
+ *   - 桶邊界：31/32（直接桶與對數桶交界）、每個值落在上界不低於自身的最小桶、UINT32_MAX 夾限
+ *   - 已知分佈的 p50/p99/max
+ *   - 空位用完時擠出最舊的 span、超過 SPAN_TIMEOUT_US 的 span 回收，都計入 expired
+ */
+
+#include "../src/platform_openwrt.c"
+#include "test_util.h"
+
+static platform_span_stats_t stats(void) {
+    platform_span_stats_t st;
+
+    platform_get_span_stats(&st, 0);
+    return st;
+}
+
+static void reset_spans(void) {
+    memset(&g_spans, 0, sizeof(g_spans));
+}
+
+/* ============================================================================
+ * 測試案例
+ * ========================================================================== */
+
+/** 直接桶到 31，32 起為對數桶（每桶 4 us），上界不低估任何值 */
+static void test_bucket_boundaries(void) {
+    CHECK(span_bucket(31) == 31, "bucket(31) %u", span_bucket(31));
+    CHECK(span_bucket_upper(31) == 31, "upper(31) %u", span_bucket_upper(31));
+    CHECK(span_bucket(32) == SPAN_DIRECT, "bucket(32) %u", span_bucket(32));
+    CHECK(span_bucket(35) == SPAN_DIRECT, "bucket(35) %u", span_bucket(35));
+    CHECK(span_bucket(36) == SPAN_DIRECT + 1, "bucket(36) %u", span_bucket(36));
+    CHECK(span_bucket_upper(SPAN_DIRECT) == 35, "upper(32) %u", span_bucket_upper(SPAN_DIRECT));
+
+    for (uint32_t us = 0; us < 4000000; us += us < 4096 ? 1 : 97) {
+        uint32_t b = span_bucket(us);
+        if (span_bucket_upper(b) < us || (b && span_bucket_upper(b - 1) >= us)) {
+            CHECK(0, "%u us in bucket %u (upper %u)", us, b, span_bucket_upper(b));
+            break;
+        }
+    }
+
+    CHECK(span_bucket(UINT32_MAX) == SPAN_BUCKETS - 1, "bucket(UINT32_MAX) %u of %u",
+          span_bucket(UINT32_MAX), SPAN_BUCKETS);
+    CHECK(span_bucket_upper(SPAN_BUCKETS - 1) == UINT32_MAX, "last upper %u",
+          span_bucket_upper(SPAN_BUCKETS - 1));
+
+    // 超過 UINT32_MAX us（約 71 分鐘）的區間夾在最後一桶
+    reset_spans();
+    span_record(PLATFORM_SPAN_TOTAL, 0, (uint64_t)UINT32_MAX + 1000000);
+    platform_span_stats_t st = stats();
+    CHECK(st.legs[PLATFORM_SPAN_TOTAL].max_us == UINT32_MAX, "max %u",
+          st.legs[PLATFORM_SPAN_TOTAL].max_us);
+    CHECK(st.legs[PLATFORM_SPAN_TOTAL].p99_us == UINT32_MAX, "p99 %u",
+          st.legs[PLATFORM_SPAN_TOTAL].p99_us);
+}
+
+/** 1..100 ms 各一次：百分位數取所在桶的上界，但不超過 max */
+static void test_percentiles(void) {
+    reset_spans();
+    for (uint32_t i = 1; i <= 100; i++) {
+        span_record(PLATFORM_SPAN_VPN, 0, i * 1000);
+    }
+
+    platform_span_stats_t st = stats();
+    const platform_span_leg_stats_t *leg = &st.legs[PLATFORM_SPAN_VPN];
+    CHECK(leg->count == 100, "count %u", leg->count);
+    CHECK(leg->p50_us == 53247, "p50 %u, expected 53247 (bucket 49152-53247)", leg->p50_us);
+    CHECK(leg->p99_us == 100000, "p99 %u, expected 100000 (bucket upper clamped to max)",
+          leg->p99_us);
+    CHECK(leg->max_us == 100000, "max %u", leg->max_us);
+    CHECK(st.legs[PLATFORM_SPAN_TOTAL].count == 0 && st.legs[PLATFORM_SPAN_TOTAL].p50_us == 0,
+          "empty leg: count %u p50 %u", st.legs[PLATFORM_SPAN_TOTAL].count,
+          st.legs[PLATFORM_SPAN_TOTAL].p50_us);
+
+    platform_get_span_stats(&st, 1);
+    st = stats();
+    CHECK(st.legs[PLATFORM_SPAN_VPN].count == 0, "count %u after reset",
+          st.legs[PLATFORM_SPAN_VPN].count);
+}
+
+/** 逾時的 span 在下一次查詢時回收；空位用完時最舊的 span 被擠出 */
+static void test_expiry_and_eviction(void) {
+    uint64_t now = now_us();
+
+    reset_spans();
+    g_spans.slots[0].id = 1;
+    g_spans.slots[0].start_us = now - SPAN_TIMEOUT_US - 1000000;
+    g_spans.slots[1].id = 2;
+    g_spans.slots[1].start_us = now;
+
+    platform_span_stats_t st = stats();
+    CHECK(st.expired == 1 && st.open == 1, "timeout: expired %u open %u", st.expired, st.open);
+    CHECK(span_find(1, now) == NULL, "expired span still found");
+    CHECK(span_find(2, now) != NULL, "live span reclaimed");
+
+#if PLATFORM_FEATURE_BUTTON
+    uint32_t ids[SPAN_SLOTS + 1];
+
+    reset_spans();
+    for (int i = 0; i <= SPAN_SLOTS; i++) {
+        ids[i] = span_open(now + (uint64_t)i);
+    }
+    st = stats();
+    CHECK(st.expired == 1 && st.open == SPAN_SLOTS, "eviction: expired %u open %u",
+          st.expired, st.open);
+    CHECK(span_find(ids[0], now) == NULL, "oldest span not evicted");
+    CHECK(span_find(ids[SPAN_SLOTS], now) != NULL, "new span missing");
+
+    // 中止的 span 不算逾時
+    span_on_led(ids[1], LED_STATE_VPN_ERROR);
+    st = stats();
+    CHECK(st.aborted == 1 && st.expired == 1, "aborted %u expired %u", st.aborted, st.expired);
+#endif
+}
+
+int main(void) {
+    test_bucket_boundaries();
+    test_percentiles();
+    test_expiry_and_eviction();
+    return test_report("test_span");
+}
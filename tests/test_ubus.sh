@@ -0,0 +1,147 @@
+#!/bin/sh
+# gaming-platformd 的 ubus 介面測試
+#
+#   make -C tests check-ubus
+#
+# 以 -s 連到本地 ubusd，不影響系統 ubus。daemon 由 tests/Makefile 編譯，
+# LED / GPIO / CEC 預設路徑指向 TESTDIR，因此不需要目標硬體。
+# 主機上沒有 ubusd / ubus 時略過（結束碼 77）。
+
+DAEMON=${DAEMON:-./gaming-platformd}
+TESTDIR=${TESTDIR:-/tmp/gaming-platform-test}
+SOCK=$TESTDIR/ubus.sock
+OBJ=gaming.platform
+
+if ! command -v ubusd >/dev/null 2>&1 || ! command -v ubus >/dev/null 2>&1; then
+	echo "test_ubus: ubusd / ubus not found, skipped"
+	exit 77
+fi
+
+failures=0
+ubusd_pid=
+daemon_pid=
+sub_pid=
+
+fail() {
+	echo "FAIL: $*" >&2
+	failures=$((failures + 1))
+}
+
+cleanup() {
+	for pid in $sub_pid $daemon_pid $ubusd_pid; do
+		kill "$pid" 2>/dev/null
+	done
+	wait 2>/dev/null
+}
+trap cleanup EXIT INT TERM
+
+call() {
+	ubus -s "$SOCK" call "$OBJ" "$@"
+}
+
+# 等待條件成立，最多 5 秒
+wait_for() {
+	i=0
+	while ! eval "$1"; do
+		i=$((i + 1))
+		[ $i -ge 50 ] && return 1
+		sleep 0.1
+	done
+}
+
+# expect <描述> <pattern> <方法> [參數]
+expect() {
+	desc=$1 pattern=$2
+	shift 2
+	out=$(call "$@") || { fail "$desc: call failed"; return; }
+	echo "$out" | grep -q -- "$pattern" || fail "$desc: \"$pattern\" not in: $out"
+}
+
+# expect_error <描述> <方法> [參數]
+expect_error() {
+	desc=$1
+	shift
+	call "$@" >/dev/null 2>&1 && fail "$desc: accepted"
+}
+
+# 假的 sysfs LED 目錄
+for led in red green blue; do
+	mkdir -p "$TESTDIR/leds/$led"
+	for attr in brightness trigger delay_on delay_off device_name link rx tx; do
+		: > "$TESTDIR/leds/$led/$attr"
+	done
+done
+
+rm -f "$SOCK"
+ubusd -s "$SOCK" &
+ubusd_pid=$!
+wait_for '[ -S "$SOCK" ]' || { echo "test_ubus: ubusd did not start"; exit 1; }
+
+# start_daemon [參數]：stderr 記錄到 daemon.log
+start_daemon() {
+	"$DAEMON" -s "$SOCK" "$@" 2> "$TESTDIR/daemon.log" &
+	daemon_pid=$!
+	wait_for 'ubus -s "$SOCK" list "$OBJ" >/dev/null 2>&1' || {
+		echo "test_ubus: $OBJ not registered"
+		exit 1
+	}
+}
+
+stop_daemon() {
+	kill "$daemon_pid" 2>/dev/null
+	wait "$daemon_pid" 2>/dev/null
+	daemon_pid=
+	wait_for '! ubus -s "$SOCK" list "$OBJ" >/dev/null 2>&1'
+}
+
+start_daemon
+
+# 物件與方法
+methods=$(ubus -s "$SOCK" list -v "$OBJ")
+for m in info get_led set_led clear_led_traffic get_calibration get_span_stats; do
+	echo "$methods" | grep -q "\"$m\"" || fail "list -v: $m missing"
+done
+
+expect "info version" '"version"' info
+expect "info device_type" '"device_type"' info
+
+# LED：狀態、自定義顏色、流量指示恢復
+expect "set_led state" '"state": "vpn_connected"' set_led '{"state":"vpn_connected"}'
+expect "get_led state" '"state": "vpn_connected"' get_led
+expect "set_led rgb" '"b": 255' set_led '{"r":0,"g":0,"b":255}'
+expect "get_led rgb" '"b": 255' get_led
+expect "set_led traffic" '"state": "vpn_traffic"' set_led '{"state":"vpn_traffic"}'
+expect "clear_led_traffic" '"b": 255' clear_led_traffic
+[ "$(cat "$TESTDIR/leds/blue/brightness")" = 255 ] || fail "blue brightness not restored"
+
+# 無效參數
+expect_error "unknown state" set_led '{"state":"bogus"}'
+expect_error "rgb out of range" set_led '{"r":300,"g":0,"b":0}'
+expect_error "rgb incomplete" set_led '{"r":1}'
+expect_error "empty set_led" set_led '{}'
+
+expect "get_calibration" '"poll_min_ms"' get_calibration
+expect "get_span_stats" '"expired"' get_span_stats '{"reset":true}'
+expect "get_span_stats legs" '"total"' get_span_stats
+
+# 通知
+ubus -s "$SOCK" subscribe "$OBJ" > "$TESTDIR/events" 2>&1 &
+sub_pid=$!
+sleep 0.5
+call set_led '{"state":"ps5_on"}' >/dev/null || fail "set_led ps5_on"
+wait_for 'grep -q "ps5_on" "$TESTDIR/events"' || fail "led notification missing: $(cat "$TESTDIR/events")"
+
+# 按鈕線路：訂閱不會取得線路，只有 -b 才會（GPIO chip 指向不存在的路徑，取得失敗時記錄並重試）
+sleep 0.5
+grep -q "retrying" "$TESTDIR/daemon.log" && fail "subscription took the button lines"
+kill "$sub_pid" 2>/dev/null
+sub_pid=
+stop_daemon
+start_daemon -b
+wait_for 'grep -q "retrying" "$TESTDIR/daemon.log"' || fail "-b did not request the button lines"
+
+if [ $failures -ne 0 ]; then
+	echo "test_ubus: $failures check(s) failed"
+	exit 1
+fi
+echo "test_ubus: OK"
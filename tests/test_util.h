@@ -0,0 +1,104 @@
+/**
+ * @file test_util.h
+ * @brief 主機端測試共用的檢查巨集與測試環境
+ *
+ * 每個測試程式只有一個翻譯單元，函式定義為 static inline，未使用時不產生警告。
+ * 路徑都在 TEST_DIR 之下（由 tests/Makefile 定義）。
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "platform_config.h"
+#include "platform_interface.h"
+
+static const char *const k_led_names[] = { "red", "green", "blue" };
+static int g_failures;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__);    \
+        fprintf(stderr, __VA_ARGS__);                           \
+        fputc('\n', stderr);                                    \
+        g_failures++;                                           \
+    }                                                           \
+} while (0)
+
+static inline void write_file(const char *path, const void *data, size_t len) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || write(fd, data, len) != (ssize_t)len) {
+        fprintf(stderr, "Cannot write %s: %s\n", path, strerror(errno));
+        exit(2);
+    }
+    close(fd);
+}
+
+/** 建立假的 sysfs LED 目錄並清空所有屬性檔；sysfs 每次寫入取代整個值，一般檔案則需先截斷 */
+static inline void reset_leds(void) {
+    static const char *const attrs[] = {
+        "brightness", "trigger", "delay_on", "delay_off",
+        "device_name", "link", "rx", "tx",
+    };
+    char path[256];
+
+    mkdir(TEST_DIR "/leds", 0755);
+    for (int i = 0; i < 3; i++) {
+        snprintf(path, sizeof(path), TEST_DIR "/leds/%s", k_led_names[i]);
+        mkdir(path, 0755);
+        for (size_t j = 0; j < sizeof(attrs) / sizeof(attrs[0]); j++) {
+            snprintf(path, sizeof(path), TEST_DIR "/leds/%s/%s", k_led_names[i], attrs[j]);
+            write_file(path, "", 0);
+        }
+    }
+}
+
+static inline void read_led(int channel, const char *attr, char *buf, size_t size) {
+    char path[256];
+
+    snprintf(path, sizeof(path), TEST_DIR "/leds/%s/%s", k_led_names[channel], attr);
+    buf[0] = '\0';
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        ssize_t n = read(fd, buf, size - 1);
+        buf[n > 0 ? n : 0] = '\0';
+        close(fd);
+    }
+}
+
+/** 預設配置，LED 指向假的 sysfs 目錄，GPIO / CEC 指向不存在的裝置 */
+static inline void test_config_defaults(platform_config_t *cfg) {
+    platform_config_defaults(cfg);
+    snprintf(cfg->led_red, sizeof(cfg->led_red), TEST_DIR "/leds/red");
+    snprintf(cfg->led_green, sizeof(cfg->led_green), TEST_DIR "/leds/green");
+    snprintf(cfg->led_blue, sizeof(cfg->led_blue), TEST_DIR "/leds/blue");
+    snprintf(cfg->gpio_chip, sizeof(cfg->gpio_chip), TEST_DIR "/gpiochip-missing");
+    snprintf(cfg->cec_device, sizeof(cfg->cec_device), TEST_DIR "/cec-missing");
+}
+
+/** 計算 CRC 後寫入 config blob */
+static inline void test_write_config(const platform_config_t *cfg) {
+    platform_config_t copy = *cfg;
+
+    copy.header.crc32 = platform_config_checksum(&copy);
+    write_file(PLATFORM_CONFIG_BLOB_PATH, &copy, sizeof(copy));
+}
+
+/** 輸出結果並返回 main() 的結束碼 */
+static inline int test_report(const char *name) {
+    if (g_failures) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, g_failures);
+        return 1;
+    }
+    printf("%s: OK\n", name);
+    return 0;
+}
+
+#endif /* TEST_UTIL_H */